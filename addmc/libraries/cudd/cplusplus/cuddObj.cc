@@ -2611,6 +2611,40 @@ ADD::ExistAbstract(
 } // ADD::ExistAbstract
 
 
+ADD
+ADD::TimesAbstract(
+  const ADD& g,
+  const ADD& cube,
+  CUDD_VALUE_TYPE const * negativeWeights,
+  CUDD_VALUE_TYPE const * positiveWeights,
+  bool additive,
+  bool logarithmic) const
+{
+    DdManager *mgr = checkSameManager(g);
+    checkSameManager(cube);
+    DdNode *result = Cudd_addTimesAbstract(mgr, node, g.node, cube.node, negativeWeights, positiveWeights, additive, logarithmic);
+    checkReturnValue(result);
+    return ADD(p, result);
+
+} // ADD::TimesAbstract
+
+
+ADD
+ADD::WeightedAbstract(
+  const ADD& cube,
+  CUDD_VALUE_TYPE const * negativeWeights,
+  CUDD_VALUE_TYPE const * positiveWeights,
+  bool additive,
+  bool logarithmic) const
+{
+    DdManager *mgr = checkSameManager(cube);
+    DdNode *result = Cudd_addWeightedAbstract(mgr, node, cube.node, negativeWeights, positiveWeights, additive, logarithmic);
+    checkReturnValue(result);
+    return ADD(p, result);
+
+} // ADD::WeightedAbstract
+
+
 ADD
 ADD::UnivAbstract(
   const ADD& cube) const
@@ -3646,6 +3680,17 @@ ADD::BddPattern() const
 } // ADD::BddPattern
 
 
+ADD
+ADD::Transfer(
+  const Cudd& destination) const
+{
+    DdManager *mgr = p->manager;
+    DdNode *result = Cudd_addTransfer(mgr, destination.p->manager, node);
+    return ADD(destination, result); // checks error code of destination manager
+
+} // ADD::Transfer
+
+
 BDD
 BDD::Transfer(
   Cudd& destination) const
@@ -316,6 +316,8 @@ public:
     ADD operator|=(const ADD& other);
     bool IsZero() const;
     ADD ExistAbstract(const ADD& cube) const;
+    ADD WeightedAbstract(const ADD& cube, CUDD_VALUE_TYPE const * negativeWeights, CUDD_VALUE_TYPE const * positiveWeights, bool additive, bool logarithmic) const;
+    ADD TimesAbstract(const ADD& g, const ADD& cube, CUDD_VALUE_TYPE const * negativeWeights, CUDD_VALUE_TYPE const * positiveWeights, bool additive, bool logarithmic) const;
     ADD UnivAbstract(const ADD& cube) const;
     ADD OrAbstract(const ADD& cube) const;
     ADD Plus(const ADD& g) const;
@@ -353,6 +355,7 @@ public:
     BDD BddInterval(CUDD_VALUE_TYPE lower, CUDD_VALUE_TYPE upper) const;
     BDD BddIthBit(int bit) const;
     BDD BddPattern() const;
+    ADD Transfer(const Cudd& destination) const;
     ADD Cofactor(const ADD& g) const;
     ADD Compose(const ADD& g, int v) const;
     ADD Permute(int * permut) const;
@@ -665,6 +665,8 @@ extern int Cudd_bddBindVar(DdManager *dd, int index);
 extern int Cudd_bddUnbindVar(DdManager *dd, int index);
 extern int Cudd_bddVarIsBound(DdManager *dd, int index);
 extern DdNode * Cudd_addExistAbstract(DdManager *manager, DdNode *f, DdNode *cube);
+extern DdNode * Cudd_addWeightedAbstract(DdManager *manager, DdNode *f, DdNode *cube, CUDD_VALUE_TYPE const *negativeWeights, CUDD_VALUE_TYPE const *positiveWeights, int additive, int logarithmic);
+extern DdNode * Cudd_addTimesAbstract(DdManager *manager, DdNode *f, DdNode *g, DdNode *cube, CUDD_VALUE_TYPE const *negativeWeights, CUDD_VALUE_TYPE const *positiveWeights, int additive, int logarithmic);
 extern DdNode * Cudd_addUnivAbstract(DdManager *manager, DdNode *f, DdNode *cube);
 extern DdNode * Cudd_addOrAbstract(DdManager *manager, DdNode *f, DdNode *cube);
 extern DdNode * Cudd_addApply(DdManager *dd, DD_AOP op, DdNode *f, DdNode *g);
@@ -759,6 +761,7 @@ extern DdNode * Cudd_addBddIthBit(DdManager *dd, DdNode *f, int bit);
 extern DdNode * Cudd_BddToAdd(DdManager *dd, DdNode *B);
 extern DdNode * Cudd_addBddPattern(DdManager *dd, DdNode *f);
 extern DdNode * Cudd_bddTransfer(DdManager *ddSource, DdManager *ddDestination, DdNode *f);
+extern DdNode * Cudd_addTransfer(DdManager *ddSource, DdManager *ddDestination, DdNode *f);
 extern int Cudd_DebugCheck(DdManager *table);
 extern int Cudd_CheckKeys(DdManager *table);
 extern DdNode * Cudd_bddClippingAnd(DdManager *dd, DdNode *f, DdNode *g, int maxDepth, int direction);
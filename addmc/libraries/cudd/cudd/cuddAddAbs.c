@@ -77,6 +77,8 @@
 /*---------------------------------------------------------------------------*/
 
 static int addCheckPositiveCube (DdManager *manager, DdNode *cube);
+static DdNode * addTimesConstant (DdManager *manager, DdNode *f, CUDD_VALUE_TYPE value, int logarithmic);
+static CUDD_VALUE_TYPE addCombineValues (CUDD_VALUE_TYPE value0, CUDD_VALUE_TYPE value1, int additive, int logarithmic);
 
 /** \endcond */
 
@@ -205,6 +207,89 @@ Cudd_addOrAbstract(
 } /* end of Cudd_addOrAbstract */
 
 
+/**
+  @brief Multiplies f and g while abstracting the variables in cube.
+
+  @details Computes the weighted abstraction of the product f * g
+  without building the product first.  A variable x of cube is
+  replaced by (negativeWeights[x] * h|x=0) op (positiveWeights[x] *
+  h|x=1), where op is plus if additive and maximum otherwise.  If
+  logarithmic, then all values (weights included) are base-10 logs:
+  products become sums and sums become log-sum-exps.  Weights must be
+  non-negative, and they must not change between calls on the same
+  manager, because they are not part of the computed-table key.
+
+  @return the abstracted %ADD if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_addExistAbstract Cudd_bddAndAbstract
+
+*/
+DdNode *
+Cudd_addTimesAbstract(
+  DdManager * manager,
+  DdNode * f,
+  DdNode * g,
+  DdNode * cube,
+  CUDD_VALUE_TYPE const * negativeWeights,
+  CUDD_VALUE_TYPE const * positiveWeights,
+  int additive,
+  int logarithmic)
+{
+    DdNode *res;
+
+    if (addCheckPositiveCube(manager, cube) == 0) {
+        (void) fprintf(manager->err,"Error: Can only abstract cubes");
+        return(NULL);
+    }
+
+    do {
+	manager->reordered = 0;
+	res = cuddAddTimesAbstractRecur(manager, f, g, cube, negativeWeights,
+					positiveWeights, additive, logarithmic);
+    } while (manager->reordered == 1);
+    if (manager->errorCode == CUDD_TIMEOUT_EXPIRED && manager->timeoutHandler) {
+        manager->timeoutHandler(manager, manager->tohArg);
+    }
+    return(res);
+
+} /* end of Cudd_addTimesAbstract */
+
+
+/**
+  @brief Abstracts all the variables in cube from f with literal
+  weights.
+
+  @details Same as Cudd_addTimesAbstract with g being the
+  multiplicative identity, so that f is traversed only once no matter
+  how many variables are abstracted.
+
+  @return the abstracted %ADD if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_addTimesAbstract
+
+*/
+DdNode *
+Cudd_addWeightedAbstract(
+  DdManager * manager,
+  DdNode * f,
+  DdNode * cube,
+  CUDD_VALUE_TYPE const * negativeWeights,
+  CUDD_VALUE_TYPE const * positiveWeights,
+  int additive,
+  int logarithmic)
+{
+    DdNode *one = logarithmic ? DD_ZERO(manager) : DD_ONE(manager);
+
+    return(Cudd_addTimesAbstract(manager, f, one, cube, negativeWeights,
+				 positiveWeights, additive, logarithmic));
+
+} /* end of Cudd_addWeightedAbstract */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -512,6 +597,173 @@ cuddAddOrAbstractRecur(
 } /* end of cuddAddOrAbstractRecur */
 
 
+/**
+  @brief Performs the recursive step of Cudd_addTimesAbstract.
+
+  @return the %ADD obtained by abstracting the variables of cube from
+  f * g if successful; NULL otherwise.
+
+  @sideeffect None
+
+*/
+DdNode *
+cuddAddTimesAbstractRecur(
+  DdManager * manager,
+  DdNode * f,
+  DdNode * g,
+  DdNode * cube,
+  CUDD_VALUE_TYPE const * negativeWeights,
+  CUDD_VALUE_TYPE const * positiveWeights,
+  int additive,
+  int logarithmic)
+{
+    DdNode *zero, *tmp, *fT, *fE, *gT, *gE, *res, *res1, *res2, *term1, *term2;
+    DD_AOP times;
+    int topf, topg, top, index;
+    ptruint tag;
+    CUDD_VALUE_TYPE weight;
+
+    statLine(manager);
+    zero = logarithmic ? DD_MINUS_INFINITY(manager) : DD_ZERO(manager);
+    times = logarithmic ? Cudd_addPlus : Cudd_addTimes;
+
+    /* Terminal cases. */
+    if (f == zero || g == zero) {
+	return(zero);
+    }
+    if (cuddIsConstant(cube)) {
+	return(cuddAddApplyRecur(manager, times, f, g));
+    }
+
+    topf = cuddI(manager,f->index);
+    topg = cuddI(manager,g->index);
+    top = ddMin(topf,topg);
+
+    /* Abstract a variable that does not appear in f * g => multiply by
+    ** its combined weight. */
+    if (top > cuddI(manager,cube->index)) {
+	res1 = cuddAddTimesAbstractRecur(manager, f, g, cuddT(cube),
+					 negativeWeights, positiveWeights,
+					 additive, logarithmic);
+	if (res1 == NULL) return(NULL);
+	cuddRef(res1);
+	weight = addCombineValues(negativeWeights[cube->index],
+				  positiveWeights[cube->index],
+				  additive, logarithmic);
+	res = addTimesConstant(manager, res1, weight, logarithmic);
+	if (res == NULL) {
+	    Cudd_RecursiveDeref(manager,res1);
+	    return(NULL);
+	}
+	cuddRef(res);
+	Cudd_RecursiveDeref(manager,res1);
+	cuddDeref(res);
+	return(res);
+    }
+
+    /* Normalize the commutative operands for the cache. */
+    if (f > g) {
+	tmp = f;
+	f = g;
+	g = tmp;
+	topf = cuddI(manager,f->index);
+	topg = cuddI(manager,g->index);
+    }
+    tag = additive ? DD_ADD_TIMES_SUM_ABSTRACT_TAG : DD_ADD_TIMES_MAX_ABSTRACT_TAG;
+    if ((res = cuddCacheLookup(manager, tag, f, g, cube)) != NULL) {
+	return(res);
+    }
+
+    checkWhetherToGiveUp(manager);
+
+    if (topf == top) {
+	index = f->index;
+	fT = cuddT(f);
+	fE = cuddE(f);
+    } else {
+	index = g->index;
+	fT = fE = f;
+    }
+    if (topg == top) {
+	gT = cuddT(g);
+	gE = cuddE(g);
+    } else {
+	gT = gE = g;
+    }
+
+    if (index == (int) cube->index) {
+	res1 = cuddAddTimesAbstractRecur(manager, fT, gT, cuddT(cube),
+					 negativeWeights, positiveWeights,
+					 additive, logarithmic);
+	if (res1 == NULL) return(NULL);
+	cuddRef(res1);
+	term1 = addTimesConstant(manager, res1, positiveWeights[index], logarithmic);
+	if (term1 == NULL) {
+	    Cudd_RecursiveDeref(manager,res1);
+	    return(NULL);
+	}
+	cuddRef(term1);
+	Cudd_RecursiveDeref(manager,res1);
+	res2 = cuddAddTimesAbstractRecur(manager, fE, gE, cuddT(cube),
+					 negativeWeights, positiveWeights,
+					 additive, logarithmic);
+	if (res2 == NULL) {
+	    Cudd_RecursiveDeref(manager,term1);
+	    return(NULL);
+	}
+	cuddRef(res2);
+	term2 = addTimesConstant(manager, res2, negativeWeights[index], logarithmic);
+	if (term2 == NULL) {
+	    Cudd_RecursiveDeref(manager,term1);
+	    Cudd_RecursiveDeref(manager,res2);
+	    return(NULL);
+	}
+	cuddRef(term2);
+	Cudd_RecursiveDeref(manager,res2);
+	res = cuddAddApplyRecur(manager,
+				additive ? (logarithmic ? Cudd_addLogSumExp : Cudd_addPlus) : Cudd_addMaximum,
+				term1, term2);
+	if (res == NULL) {
+	    Cudd_RecursiveDeref(manager,term1);
+	    Cudd_RecursiveDeref(manager,term2);
+	    return(NULL);
+	}
+	cuddRef(res);
+	Cudd_RecursiveDeref(manager,term1);
+	Cudd_RecursiveDeref(manager,term2);
+	cuddCacheInsert(manager, tag, f, g, cube, res);
+	cuddDeref(res);
+	return(res);
+    } else { /* top variable of f * g is above cube */
+	res1 = cuddAddTimesAbstractRecur(manager, fT, gT, cube,
+					 negativeWeights, positiveWeights,
+					 additive, logarithmic);
+	if (res1 == NULL) return(NULL);
+	cuddRef(res1);
+	res2 = cuddAddTimesAbstractRecur(manager, fE, gE, cube,
+					 negativeWeights, positiveWeights,
+					 additive, logarithmic);
+	if (res2 == NULL) {
+	    Cudd_RecursiveDeref(manager,res1);
+	    return(NULL);
+	}
+	cuddRef(res2);
+	res = (res1 == res2) ? res1 :
+	    cuddUniqueInter(manager, index, res1, res2);
+	if (res == NULL) {
+	    Cudd_RecursiveDeref(manager,res1);
+	    Cudd_RecursiveDeref(manager,res2);
+	    return(NULL);
+	}
+	cuddDeref(res1);
+	cuddDeref(res2);
+	cuddCacheInsert(manager, tag, f, g, cube, res);
+	return(res);
+    }
+
+} /* end of cuddAddTimesAbstractRecur */
+
+
 
 /*---------------------------------------------------------------------------*/
 /* Definition of static functions                                            */
@@ -541,3 +793,66 @@ addCheckPositiveCube(
     return(0);
 
 } /* end of addCheckPositiveCube */
+
+
+/**
+  @brief Multiplies f by a constant.
+
+  @return f * value (f + value if logarithmic) if successful; NULL
+  otherwise.
+
+  @sideeffect None
+
+*/
+static DdNode *
+addTimesConstant(
+  DdManager * manager,
+  DdNode * f,
+  CUDD_VALUE_TYPE value,
+  int logarithmic)
+{
+    DdNode *constant, *res;
+
+    constant = cuddUniqueConst(manager, value);
+    if (constant == NULL) return(NULL);
+    cuddRef(constant);
+    res = cuddAddApplyRecur(manager, logarithmic ? Cudd_addPlus : Cudd_addTimes,
+			    f, constant);
+    if (res == NULL) {
+	Cudd_RecursiveDeref(manager,constant);
+	return(NULL);
+    }
+    cuddRef(res);
+    Cudd_RecursiveDeref(manager,constant);
+    cuddDeref(res);
+    return(res);
+
+} /* end of addTimesConstant */
+
+
+/**
+  @brief Combines the two literal weights of a variable that does not
+  appear in the function being abstracted.
+
+  @return value0 + value1 (log-sum-exp if logarithmic) if additive;
+  max(value0, value1) otherwise.
+
+  @sideeffect None
+
+*/
+static CUDD_VALUE_TYPE
+addCombineValues(
+  CUDD_VALUE_TYPE value0,
+  CUDD_VALUE_TYPE value1,
+  int additive,
+  int logarithmic)
+{
+    CUDD_VALUE_TYPE m;
+
+    if (!additive) return(fmax(value0, value1));
+    if (!logarithmic) return(value0 + value1);
+    m = fmax(value0, value1);
+    if (m == -INFINITY) return(m);
+    return(log10(exp10(value0 - m) + exp10(value1 - m)) + m);
+
+} /* end of addCombineValues */
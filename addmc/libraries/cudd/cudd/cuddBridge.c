@@ -83,6 +83,7 @@ static DdNode * addBddDoInterval (DdManager *dd, DdNode *f, DdNode *l, DdNode *u
 static DdNode * addBddDoIthBit (DdManager *dd, DdNode *f, DdNode *index);
 static DdNode * ddBddToAddRecur (DdManager *dd, DdNode *B);
 static DdNode * cuddBddTransferRecur (DdManager *ddS, DdManager *ddD, DdNode *f, st_table *table);
+static DdNode * cuddAddTransferRecur (DdManager *ddS, DdManager *ddD, DdNode *f, st_table *table);
 
 /** \endcond */
 
@@ -395,6 +396,46 @@ Cudd_bddTransfer(
 } /* end of Cudd_bddTransfer */
 
 
+/**
+  @brief Convert an %ADD from a manager to another one.
+
+  @details The orders of the variables in the two managers may be
+  different. The source manager is only read: no node of it is
+  created, referenced or dereferenced, and only the index, children
+  and values of the nodes of f are read. Another thread may keep
+  using the source manager meanwhile only if f stays referenced
+  there, so that garbage collection does not free its nodes, and if
+  reordering is disabled there, as it rewrites live nodes. Garbage
+  collection only relinks unique-table chains, which are not read.
+
+  @return a pointer to the %ADD in the destination manager if
+  successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_bddTransfer
+
+*/
+DdNode *
+Cudd_addTransfer(
+  DdManager * ddSource,
+  DdManager * ddDestination,
+  DdNode * f)
+{
+    DdNode *res;
+    do {
+	ddDestination->reordered = 0;
+	res = cuddAddTransfer(ddSource, ddDestination, f);
+    } while (ddDestination->reordered == 1);
+    if (ddDestination->errorCode == CUDD_TIMEOUT_EXPIRED &&
+        ddDestination->timeoutHandler) {
+        ddDestination->timeoutHandler(ddDestination, ddDestination->tohArg);
+    }
+    return(res);
+
+} /* end of Cudd_addTransfer */
+
+
 /*---------------------------------------------------------------------------*/
 /* Definition of internal functions                                          */
 /*---------------------------------------------------------------------------*/
@@ -449,6 +490,53 @@ failure:
 } /* end of cuddBddTransfer */
 
 
+/**
+  @brief Convert an %ADD from a manager to another one.
+
+  @return a pointer to the %ADD in the destination manager if
+  successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see Cudd_addTransfer
+
+*/
+DdNode *
+cuddAddTransfer(
+  DdManager * ddS,
+  DdManager * ddD,
+  DdNode * f)
+{
+    DdNode *res;
+    st_table *table = NULL;
+    st_generator *gen = NULL;
+    DdNode *key, *value;
+
+    table = st_init_table(st_ptrcmp,st_ptrhash);
+    if (table == NULL) goto failure;
+    res = cuddAddTransferRecur(ddS, ddD, f, table);
+    if (res != NULL) cuddRef(res);
+
+    /* Dereference all elements in the table and dispose of the table. */
+    gen = st_init_gen(table);
+    if (gen == NULL) goto failure;
+    while (st_gen(gen, (void **) &key, (void **) &value)) {
+	Cudd_RecursiveDeref(ddD, value);
+    }
+    st_free_gen(gen); gen = NULL;
+    st_free_table(table); table = NULL;
+
+    if (res != NULL) cuddDeref(res);
+    return(res);
+
+failure:
+    /* No need to free gen because it is always NULL here. */
+    if (table != NULL) st_free_table(table);
+    return(NULL);
+
+} /* end of cuddAddTransfer */
+
+
 /**
   @brief Performs the recursive step for Cudd_addBddPattern.
 
@@ -984,3 +1072,77 @@ cuddBddTransferRecur(
 
 } /* end of cuddBddTransferRecur */
 
+
+/**
+  @brief Performs the recursive step of Cudd_addTransfer.
+
+  @return a pointer to the result if successful; NULL otherwise.
+
+  @sideeffect None
+
+  @see cuddAddTransfer
+
+*/
+static DdNode *
+cuddAddTransferRecur(
+  DdManager * ddS,
+  DdManager * ddD,
+  DdNode * f,
+  st_table * table)
+{
+    DdNode *ft, *fe, *t, *e, *var, *res;
+    unsigned int index;
+
+    statLine(ddD);
+
+    /* Trivial cases. */
+    if (cuddIsConstant(f)) return(cuddUniqueConst(ddD, cuddV(f)));
+
+    /* Check the cache. */
+    if (st_lookup(table, f, (void **) &res))
+	return(res);
+
+    /* Recursive step. */
+    index = f->index;
+    ft = cuddT(f); fe = cuddE(f);
+
+    t = cuddAddTransferRecur(ddS, ddD, ft, table);
+    if (t == NULL) {
+    	return(NULL);
+    }
+    cuddRef(t);
+
+    e = cuddAddTransferRecur(ddS, ddD, fe, table);
+    if (e == NULL) {
+    	Cudd_RecursiveDeref(ddD, t);
+    	return(NULL);
+    }
+    cuddRef(e);
+
+    var = cuddUniqueInter(ddD,index,DD_ONE(ddD),DD_ZERO(ddD));
+    if (var == NULL) {
+	Cudd_RecursiveDeref(ddD, t);
+	Cudd_RecursiveDeref(ddD, e);
+    	return(NULL);
+    }
+    cuddRef(var);
+    res = cuddAddIteRecur(ddD,var,t,e);
+    if (res == NULL) {
+	Cudd_RecursiveDeref(ddD, var);
+	Cudd_RecursiveDeref(ddD, t);
+	Cudd_RecursiveDeref(ddD, e);
+	return(NULL);
+    }
+    cuddRef(res);
+    Cudd_RecursiveDeref(ddD, var);
+    Cudd_RecursiveDeref(ddD, t);
+    Cudd_RecursiveDeref(ddD, e);
+
+    if (st_add_direct(table, f, res) == ST_OUT_OF_MEM) {
+	Cudd_RecursiveDeref(ddD, res);
+	return(NULL);
+    }
+    return(res);
+
+} /* end of cuddAddTransferRecur */
+
@@ -152,6 +152,8 @@
 #define DD_BDD_MAX_EXP_TAG 0x8a
 #define DD_VARS_SYMM_BEFORE_TAG 0x8e
 #define DD_VARS_SYMM_BETWEEN_TAG 0xa2
+#define DD_ADD_TIMES_SUM_ABSTRACT_TAG 0xa6
+#define DD_ADD_TIMES_MAX_ABSTRACT_TAG 0xaa
 
 /* Generator constants. */
 #define CUDD_GEN_CUBES 0
@@ -1056,6 +1058,7 @@ extern "C" {
 #endif
 
 extern DdNode * cuddAddExistAbstractRecur(DdManager *manager, DdNode *f, DdNode *cube);
+extern DdNode * cuddAddTimesAbstractRecur(DdManager *manager, DdNode *f, DdNode *g, DdNode *cube, CUDD_VALUE_TYPE const *negativeWeights, CUDD_VALUE_TYPE const *positiveWeights, int additive, int logarithmic);
 extern DdNode * cuddAddUnivAbstractRecur(DdManager *manager, DdNode *f, DdNode *cube);
 extern DdNode * cuddAddOrAbstractRecur(DdManager *manager, DdNode *f, DdNode *cube);
 extern DdNode * cuddAddApplyRecur(DdManager *dd, DdNode * (*)(DdManager *, DdNode **, DdNode **), DdNode *f, DdNode *g);
@@ -1078,6 +1081,7 @@ extern DdNode * cuddBddIntersectRecur(DdManager *dd, DdNode *f, DdNode *g);
 extern DdNode * cuddBddAndRecur(DdManager *manager, DdNode *f, DdNode *g);
 extern DdNode * cuddBddXorRecur(DdManager *manager, DdNode *f, DdNode *g);
 extern DdNode * cuddBddTransfer(DdManager *ddS, DdManager *ddD, DdNode *f);
+extern DdNode * cuddAddTransfer(DdManager *ddS, DdManager *ddD, DdNode *f);
 extern DdNode * cuddAddBddDoPattern(DdManager *dd, DdNode *f);
 extern int cuddInitCache(DdManager *unique, unsigned int cacheSize, unsigned int maxCacheSize);
 extern void cuddCacheInsert(DdManager *table, ptruint op, DdNode *f, DdNode *g, DdNode *h, DdNode *data);
@@ -6,12 +6,23 @@ Int dotFileIndex = 1;
 
 bool existRandom;
 bool maximizingAssignment;
+bool recomputingMaximizer;
 Int threadCount;
 Int threadSliceCount;
+bool workStealing;
+bool subtreeMemo;
+Int splitBudget;
+bool workerProcesses;
+Int clusterRole;
+string clusterAddress;
+string journalFilePath;
 string ddPackage;
 Float memSensitivity;
 Float maxMem;
 string joinPriority;
+bool earlyProjection;
+bool benchmarkingJoins;
+bool fusedAbstraction;
 Int verboseJoinTree;
 Int verboseProfiling;
 
@@ -309,6 +320,77 @@ Dd::Dd(const Dd& dd) {
   else {
     this->mtbdd = dd.mtbdd;
   }
+  this->nodeCount = dd.nodeCount;
+  this->supportWords = dd.supportWords;
+}
+
+uint32_t Dd::logLeafType;
+
+char* Dd::logLeafToStr(int complement, uint64_t value, char* buf, size_t bufLength) {
+  double d;
+  memcpy(&d, &value, sizeof(d));
+  snprintf(buf, bufLength, "log10:%g", d);
+  return buf;
+}
+
+void Dd::initLogLeafType() {
+  logLeafType = sylvan::sylvan_mt_create_type(); // default hash and equality compare value bits
+  sylvan::sylvan_mt_set_to_str(logLeafType, logLeafToStr);
+}
+
+MTBDD Dd::getLogLeaf(Float log10Value) {
+  double d = log10Value; // -INF for count 0
+  uint64_t value;
+  memcpy(&value, &d, sizeof(value));
+  return sylvan::mtbdd_makeleaf(logLeafType, value);
+}
+
+Float Dd::getLogLeafValue(MTBDD leaf) {
+  assert(mtbdd_isleaf(leaf) && sylvan::mtbdd_gettype(leaf) == logLeafType);
+  uint64_t value = mtbdd_getvalue(leaf);
+  double d;
+  memcpy(&d, &value, sizeof(d));
+  return d;
+}
+
+vector<CUDD_VALUE_TYPE> Dd::negativeWeights;
+vector<CUDD_VALUE_TYPE> Dd::positiveWeights;
+vector<Dd> Dd::negativeWeightDds;
+vector<Dd> Dd::positiveWeightDds;
+Dd* Dd::zeroDd = nullptr;
+uint64_t Dd::timesSumAbstractOpid;
+uint64_t Dd::timesMaxAbstractOpid;
+
+void Dd::initTimesAbstraction() {
+  timesSumAbstractOpid = cache_next_opid();
+  timesMaxAbstractOpid = cache_next_opid();
+}
+
+void Dd::setAbstractionWeights(const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights) {
+  for (Int cnfVar : ddVarToCnfVarMap) {
+    const Number& positiveWeight = literalWeights.at(cnfVar);
+    const Number& negativeWeight = literalWeights.at(-cnfVar);
+    if (ddPackage == CUDD) {
+      negativeWeights.push_back(logCounting ? negativeWeight.getLog10() : negativeWeight.fraction);
+      positiveWeights.push_back(logCounting ? positiveWeight.getLog10() : positiveWeight.fraction);
+    }
+    else {
+      negativeWeightDds.push_back(getConstDd(negativeWeight, nullptr));
+      positiveWeightDds.push_back(getConstDd(positiveWeight, nullptr));
+    }
+  }
+  if (ddPackage == SYLVAN) {
+    zeroDd = new Dd(getZeroDd(nullptr));
+  }
+}
+
+void Dd::clearAbstractionWeights() {
+  negativeWeights.clear();
+  positiveWeights.clear();
+  negativeWeightDds.clear();
+  positiveWeightDds.clear();
+  delete zeroDd;
+  zeroDd = nullptr;
 }
 
 const Cudd* Dd::newMgr(Float mem, Int threadIndex) {
@@ -335,6 +417,9 @@ Dd Dd::getConstDd(const Number& n, const Cudd* mgr) {
   if (ddPackage == CUDD) {
     return logCounting ? Dd(mgr->constant(n.getLog10())) : Dd(mgr->constant(n.fraction));
   }
+  if (logCounting) {
+    return Dd(Mtbdd(getLogLeaf(n.getLog10())));
+  }
   if (multiplePrecision) {
     mpq_t q; // C interface
     mpq_init(q);
@@ -367,15 +452,53 @@ Dd Dd::getVarDd(Int ddVar, bool val, const Cudd* mgr) {
   return Dd(mtbdd_makenode(ddVar, getOneDd(mgr).mtbdd.GetMTBDD(), getZeroDd(mgr).mtbdd.GetMTBDD()));
 }
 
-size_t Dd::countNodes() const {
+Dd Dd::getCubeDd(const vector<Int>& ddVars, const Cudd* mgr) {
   if (ddPackage == CUDD) {
-    return cuadd.nodeCount();
+    ADD cube = mgr->addOne();
+    for (Int ddVar : ddVars) {
+      cube *= mgr->addVar(ddVar);
+    }
+    return Dd(cube);
   }
-  return mtbdd.NodeCount();
+  vector<uint32_t> cubeVars(ddVars.begin(), ddVars.end());
+  std::sort(cubeVars.begin(), cubeVars.end()); // Bdd::VariablesCube expects var order
+  return Dd(Mtbdd(sylvan::Bdd::VariablesCube(cubeVars)));
+}
+
+Dd Dd::getClauseDd(vector<pair<Int, bool>> ddLiterals, const Cudd* mgr) {
+  std::sort(ddLiterals.begin(), ddLiterals.end(), std::greater<pair<Int, bool>>()); // bottom var first
+  for (Int i = 1; i < ddLiterals.size(); i++) {
+    if (ddLiterals.at(i).first == ddLiterals.at(i - 1).first && ddLiterals.at(i).second != ddLiterals.at(i - 1).second) { // tautology
+      return getOneDd(mgr);
+    }
+  }
+  ddLiterals.erase(std::unique(ddLiterals.begin(), ddLiterals.end()), ddLiterals.end());
+
+  Dd one = getOneDd(mgr);
+  Dd clauseDd = getZeroDd(mgr);
+  for (const auto& [ddVar, val] : ddLiterals) { // clauseDd has no var above ddVar
+    if (ddPackage == CUDD) {
+      ADD varDd = mgr->addVar(ddVar);
+      clauseDd = Dd(val ? varDd.Ite(one.cuadd, clauseDd.cuadd) : varDd.Ite(clauseDd.cuadd, one.cuadd));
+    }
+    else {
+      MTBDD lo = val ? clauseDd.mtbdd.GetMTBDD() : one.mtbdd.GetMTBDD();
+      MTBDD hi = val ? one.mtbdd.GetMTBDD() : clauseDd.mtbdd.GetMTBDD();
+      clauseDd = Dd(mtbdd_makenode(ddVar, lo, hi));
+    }
+  }
+  return clauseDd;
+}
+
+size_t Dd::countNodes() const {
+  if (nodeCount == 0) {
+    nodeCount = ddPackage == CUDD ? cuadd.nodeCount() : mtbdd.NodeCount();
+  }
+  return nodeCount;
 }
 
 bool Dd::operator<(const Dd& rightDd) const {
-  if (joinPriority == SMALLEST_PAIR) { // top = rightmost = smallest
+  if (joinPriority == SMALLEST_PAIR || joinPriority == OVERLAP_PAIR) { // top = rightmost = smallest
     return countNodes() > rightDd.countNodes();
   }
   return countNodes() < rightDd.countNodes();
@@ -388,6 +511,9 @@ Number Dd::extractConst() const {
     return Number(cuddV(minTerminal.getNode()));
   }
   assert(mtbdd.isLeaf());
+  if (logCounting) {
+    return Number(getLogLeafValue(mtbdd.GetMTBDD()));
+  }
   if (multiplePrecision) {
     return Number(mpq_class((mpq_ptr)mtbdd_getvalue(mtbdd.GetMTBDD())));
   }
@@ -406,10 +532,19 @@ Dd Dd::getComposition(Int ddVar, bool val, const Cudd* mgr) const {
   return Dd(mtbdd.Compose(m));
 }
 
+Dd Dd::getTransfer(const ADD& cuadd, const Cudd* mgr) {
+  assert(ddPackage == CUDD);
+  return Dd(cuadd.Transfer(*mgr)); // copying cuadd would update ref counts in manager of other thread
+}
+
 Dd Dd::getProduct(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return logCounting ? Dd(cuadd + dd.cuadd) : Dd(cuadd * dd.cuadd);
   }
+  if (logCounting) {
+    LACE_ME;
+    return Dd(Mtbdd(mtbdd_apply(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD(), TASK(logOpTimes))));
+  }
   if (multiplePrecision) {
     LACE_ME;
     return Dd(Mtbdd(gmp_times(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
@@ -421,6 +556,10 @@ Dd Dd::getSum(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return logCounting ? Dd(cuadd.LogSumExp(dd.cuadd)) : Dd(cuadd + dd.cuadd);
   }
+  if (logCounting) {
+    LACE_ME;
+    return Dd(Mtbdd(mtbdd_apply(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD(), TASK(logOpPlus))));
+  }
   if (multiplePrecision) {
     LACE_ME;
     return Dd(Mtbdd(gmp_plus(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
@@ -432,6 +571,10 @@ Dd Dd::getMax(const Dd& dd) const {
   if (ddPackage == CUDD) {
     return Dd(cuadd.Maximum(dd.cuadd));
   }
+  if (logCounting) {
+    LACE_ME;
+    return Dd(Mtbdd(mtbdd_apply(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD(), TASK(logOpMax))));
+  }
   if (multiplePrecision) {
     LACE_ME;
     return Dd(Mtbdd(gmp_max(mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD())));
@@ -456,12 +599,48 @@ Set<Int> Dd::getSupport() const {
   return support;
 }
 
+const vector<uint64_t>& Dd::getSupportWords() const {
+  if (supportWords == nullptr) {
+    supportWords = std::make_shared<vector<uint64_t>>();
+    for (Int ddVar : getSupport()) {
+      if (ddVar / 64 >= supportWords->size()) {
+        supportWords->resize(ddVar / 64 + 1);
+      }
+      supportWords->at(ddVar / 64) |= uint64_t(1) << (ddVar % 64);
+    }
+  }
+  return *supportWords;
+}
+
+Int Dd::countUnitedVars(const Dd& dd1, const Dd& dd2) {
+  const vector<uint64_t>& words1 = dd1.getSupportWords();
+  const vector<uint64_t>& words2 = dd2.getSupportWords();
+  Int count = 0;
+  for (Int wordIndex = 0; wordIndex < max(words1.size(), words2.size()); wordIndex++) {
+    uint64_t word1 = wordIndex < words1.size() ? words1.at(wordIndex) : 0;
+    uint64_t word2 = wordIndex < words2.size() ? words2.at(wordIndex) : 0;
+    count += __builtin_popcountll(word1 | word2);
+  }
+  return count;
+}
+
 Dd Dd::getBoolDiff(const Dd& rightDd) const {
   if (ddPackage == CUDD) {
     Dd gx((cuadd - rightDd.cuadd).BddThreshold(0).Add());
     return gx;
   }
-  assert(("unimplemented for Sylvan", false));
+  if (logCounting) { // log10 is monotone
+    LACE_ME;
+    return Dd(Mtbdd(mtbdd_apply(mtbdd.GetMTBDD(), rightDd.mtbdd.GetMTBDD(), TASK(logOpGeq))));
+  }
+  if (multiplePrecision) { // exact comparison with mpq zero leaf (mpq_cmp), as mpq_get_d rounds tiny differences to 0
+    LACE_ME;
+    Mtbdd diff(gmp_minus(mtbdd.GetMTBDD(), rightDd.mtbdd.GetMTBDD()));
+    Mtbdd zero = getZeroDd(nullptr).mtbdd;
+    MTBDD gx = gmp_threshold(diff.GetMTBDD(), zero.GetMTBDD());
+    return Dd(Mtbdd(gx));
+  }
+  return Dd(Mtbdd((mtbdd - rightDd.mtbdd).BddThreshold(0).GetBDD())); // Boolean leaves
 }
 
 bool Dd::evalAssignment(vector<int>& ddVarAssignment) const {
@@ -469,33 +648,54 @@ bool Dd::evalAssignment(vector<int>& ddVarAssignment) const {
     Number n = Dd(cuadd.Eval(&ddVarAssignment.front())).extractConst();
     return n == Number("1");
   }
-  assert(("unimplemented for Sylvan", false));
+  MTBDD node = mtbdd.GetMTBDD();
+  while (!mtbdd_isleaf(node)) {
+    node = ddVarAssignment.at(mtbdd_getvar(node)) ? mtbdd_gethigh(node) : mtbdd_getlow(node);
+  }
+  return node == mtbdd_true; // from getBoolDiff
 }
 
-Dd Dd::getAbstraction(Int ddVar, const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights, const Assignment& assignment, bool additive, vector<pair<Int, Dd>>& maximizerStack, const Cudd* mgr) const {
+Dd Dd::getAbstraction(Int ddVar, const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights, const Assignment& assignment, bool additive, vector<pair<Int, Dd>>* maximizerStack, const Cudd* mgr) const {
   Int cnfVar = ddVarToCnfVarMap.at(ddVar);
   Dd positiveWeight = getConstDd(literalWeights.at(cnfVar), mgr);
   Dd negativeWeight = getConstDd(literalWeights.at(-cnfVar), mgr);
 
-  auto it = assignment.find(cnfVar);
-  if (it != assignment.end()) {
-    Dd weight = it->second ? positiveWeight : negativeWeight;
+  if (assignment.contains(cnfVar)) {
+    Dd weight = assignment.at(cnfVar) ? positiveWeight : negativeWeight;
     return getProduct(weight);
   }
 
   Dd term0 = getComposition(ddVar, false, mgr).getProduct(negativeWeight);
   Dd term1 = getComposition(ddVar, true, mgr).getProduct(positiveWeight);
 
-  if (maximizingAssignment && !additive) {
+  if (maximizerStack != nullptr && !additive) {
     // assert(ddPackage == CUDD);
 
     Dd gx = term1.getBoolDiff(term0);
-    maximizerStack.push_back({ddVar, gx});
+    maximizerStack->push_back({ddVar, gx});
   }
 
   return additive ? term0.getSum(term1) : term0.getMax(term1);
 }
 
+Dd Dd::getWeightedAbstraction(const vector<Int>& ddVars, bool additive, const Cudd* mgr) const {
+  Dd cube = getCubeDd(ddVars, mgr);
+  if (ddPackage == CUDD) {
+    return Dd(cuadd.WeightedAbstract(cube.cuadd, &negativeWeights.front(), &positiveWeights.front(), additive, logCounting));
+  }
+  LACE_ME;
+  return Dd(Mtbdd(CALL(laceTimesAbstract, mtbdd.GetMTBDD(), getOneDd(mgr).mtbdd.GetMTBDD(), cube.mtbdd.GetMTBDD(), additive)));
+}
+
+Dd Dd::getTimesAbstraction(const Dd& dd, const vector<Int>& ddVars, bool additive, const Cudd* mgr) const {
+  Dd cube = getCubeDd(ddVars, mgr);
+  if (ddPackage == CUDD) {
+    return Dd(cuadd.TimesAbstract(dd.cuadd, cube.cuadd, &negativeWeights.front(), &positiveWeights.front(), additive, logCounting));
+  }
+  LACE_ME;
+  return Dd(Mtbdd(CALL(laceTimesAbstract, mtbdd.GetMTBDD(), dd.mtbdd.GetMTBDD(), cube.mtbdd.GetMTBDD(), additive)));
+}
+
 void Dd::writeDotFile(const Cudd* mgr, string dotFileDir) const {
   string filePath = dotFileDir + "dd" + to_string(dotFileIndex++) + ".dot";
   FILE* file = fopen(filePath.c_str(), "wb"); // writes to binary file
@@ -522,9 +722,107 @@ void Dd::writeInfoFile(const Cudd* mgr, string filePath) {
   cout << "c overwrote file " << filePath << "\n";
 }
 
+/* class SplitException ===================================================== */
+
+const char* SplitException::what() const noexcept {
+  return "diagram exceeded split budget";
+}
+
+SplitException::SplitException(const JoinNode* joinNode, bool memExceeded) {
+  this->joinNode = joinNode;
+  this->memExceeded = memExceeded;
+}
+
+/* class SliceJournal ======================================================= */
+
+void SliceJournal::appendLine(const string& line) {
+  string entry = line + "\n";
+  for (size_t writtenSize = 0; writtenSize < entry.size();) {
+    ssize_t chunkSize = write(fd, entry.data() + writtenSize, entry.size() - writtenSize);
+    if (chunkSize <= 0) {
+      throw MyError("failed to write journal ", filePath);
+    }
+    writtenSize += chunkSize;
+  }
+  fdatasync(fd); // survives preemption of node
+}
+
+void SliceJournal::recordSlice(Int sliceIndex, const Assignment& assignment, const Number& partialSolution) {
+  string line = "s " + to_string(sliceIndex) + " " + partialSolution.getExactString();
+  for (Int literal : Executor::getSliceLiterals(assignment)) {
+    line += " " + to_string(literal);
+  }
+  appendLine(line);
+}
+
+SliceJournal::SliceJournal(const string& filePath, size_t runHash, const vector<Assignment>& assignments) {
+  this->filePath = filePath;
+  string headerLine = "h " + to_string(runHash);
+
+  std::ifstream inputFileStream(filePath); // may not exist yet
+  string contents((std::istreambuf_iterator<char>(inputFileStream)), std::istreambuf_iterator<char>());
+  inputFileStream.close();
+
+  size_t completeSize = 0; // interrupted run may leave partial last line
+  Int lineIndex = 0;
+  for (size_t lineEnd = contents.find('\n'); lineEnd != string::npos; lineEnd = contents.find('\n', completeSize)) {
+    string line = contents.substr(completeSize, lineEnd - completeSize);
+    completeSize = lineEnd + 1;
+    lineIndex++;
+
+    if (lineIndex == 1) {
+      if (line != headerLine) {
+        throw MyError("journal ", filePath, " is from run with different cnf, join tree, or options");
+      }
+      continue;
+    }
+
+    std::istringstream lineStream(line);
+    string word;
+    Int sliceIndex = MIN_INT;
+    string numberString;
+    lineStream >> word >> sliceIndex >> numberString;
+    vector<Int> literals{istream_iterator<Int>(lineStream), istream_iterator<Int>()};
+    if (word != "s" || sliceIndex < 0 || sliceIndex >= assignments.size() || literals != Executor::getSliceLiterals(assignments.at(sliceIndex))) {
+      throw MyError("bad line ", lineIndex, " in journal ", filePath);
+    }
+    sliceSolutions.emplace(sliceIndex, Number(numberString));
+  }
+
+  if (completeSize < contents.size() && truncate(filePath.c_str(), completeSize) != 0) {
+    throw MyError("failed to truncate journal ", filePath);
+  }
+  fd = open(filePath.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0) {
+    throw MyError("failed to open journal ", filePath);
+  }
+  if (completeSize == 0) {
+    appendLine(headerLine);
+  }
+}
+
+SliceJournal::~SliceJournal() {
+  close(fd);
+}
+
 /* class Executor =========================================================== */
 
-vector<pair<Int, Dd>> Executor::maximizerStack;
+thread_local vector<pair<Int, Dd>> Executor::maximizerStack;
+thread_local Map<Int, Dd> Executor::clauseDds;
+thread_local const Cudd* Executor::clauseDdMgr;
+Map<Int, vector<pair<Int, Dd>>> Executor::sliceMaximizerStacks;
+Assignment Executor::maximizerSlice;
+
+vector<Int> Executor::sliceVars;
+Map<Int, Int> Executor::memoNodeMasks;
+Set<Int> Executor::maxProjectionNodes;
+
+std::atomic<Int> Executor::splitCount = 0;
+thread_local bool Executor::splitBudgetSuspended = false;
+std::atomic<size_t> Executor::maxDdSize = 0;
+bool Executor::probingSlice = false;
+
+SliceJournal* Executor::sliceJournal = nullptr;
 
 Map<Int, Float> Executor::varDurations;
 Map<Int, size_t> Executor::varDdSizes;
@@ -549,244 +847,1589 @@ void Executor::updateVarDurations(const JoinNode* joinNode, TimePoint startPoint
   }
 }
 
-void Executor::updateVarDdSizes(const JoinNode* joinNode, const Dd& dd) {
-  if (verboseProfiling >= 1) {
-    size_t ddSize = dd.countNodes();
+void Executor::updateVarDdSizes(const JoinNode* joinNode, const Dd& dd) {
+  if (verboseProfiling >= 1) {
+    size_t ddSize = dd.countNodes();
+
+    if (verboseProfiling >= 2) {
+      util::printRow("joinNodeDiagramSize_" + to_string(joinNode->nodeIndex + 1), ddSize);
+    }
+
+    for (Int var : joinNode->preProjectionVars) {
+      if (varDdSizes.contains(var)) {
+        varDdSizes[var] = max(varDdSizes[var], ddSize);
+      }
+      else {
+        varDdSizes[var] = ddSize;
+      }
+    }
+  }
+}
+
+void Executor::printVarDurations() {
+  multimap<Float, Int, greater<Float>> timedVars = util::flipMap(varDurations); // duration |-> var
+  for (pair<Float, Int> timedVar : timedVars) {
+    util::printRow("varTotalSeconds_" + to_string(timedVar.second), timedVar.first);
+  }
+}
+
+void Executor::printVarDdSizes() {
+  multimap<size_t, Int, greater<size_t>> sizedVars = util::flipMap(varDdSizes); // dd size |-> var
+  for (pair<size_t, Int> sizedVar : sizedVars) {
+    util::printRow("varMaxDiagramSize_" + to_string(sizedVar.second), sizedVar.first);
+  }
+}
+
+void Executor::releaseClauseDds() {
+  clauseDds.clear();
+  clauseDdMgr = nullptr;
+}
+
+Dd Executor::getClauseDd(const Map<Int, Int>& cnfVarToDdVarMap, Int clauseIndex, const Cudd* mgr, const Assignment& assignment) {
+  Clause clause = JoinNode::cnf.getClause(clauseIndex);
+  bool sliced = false;
+  for (Int literal : clause) {
+    Int cnfVar = abs(literal);
+    if (assignment.contains(cnfVar)) {
+      if (assignment.at(cnfVar) == (literal > 0)) { // returns satisfied clause
+        return Dd::getOneDd(mgr);
+      }
+      sliced = true;
+    }
+  }
+
+  if (!sliced && ddPackage == CUDD) { // Sylvan diagrams must not outlive sylvan_quit in thread-local storage
+    if (clauseDdMgr != mgr) {
+      clauseDds.clear();
+      clauseDdMgr = mgr;
+    }
+    auto it = clauseDds.find(clauseIndex);
+    if (it != clauseDds.end()) {
+      return it->second;
+    }
+  }
+
+  vector<pair<Int, bool>> ddLiterals;
+  for (Int literal : clause) {
+    if (!assignment.contains(abs(literal))) { // excludes unsatisfied literal
+      ddLiterals.push_back({cnfVarToDdVarMap.at(abs(literal)), literal > 0});
+    }
+  }
+  Dd clauseDd = Dd::getClauseDd(ddLiterals, mgr);
+  if (!sliced && ddPackage == CUDD) {
+    clauseDds.insert({clauseIndex, clauseDd});
+  }
+  return clauseDd;
+}
+
+void Executor::checkSplitBudget(const Dd& dd, const JoinNode* joinNode) {
+  if (splitBudget > 0 && !splitBudgetSuspended && dd.countNodes() > splitBudget) {
+    throw SplitException(joinNode, false);
+  }
+  if (benchmarkingJoins || probingSlice) { // every intermediate diagram passes here
+    size_t ddSize = dd.countNodes();
+    size_t oldMax = maxDdSize;
+    while (ddSize > oldMax && !maxDdSize.compare_exchange_weak(oldMax, ddSize)) {} // oldMax is refreshed on failure
+  }
+}
+
+Dd Executor::joinChildDds(const JoinNode* joinNode, const vector<Dd>& childDdList, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment, vector<pair<Int, Dd>>* maximizerStack) {
+  TimePoint nonterminalStartPoint = util::getTimePoint();
+
+  vector<pair<bool, vector<Int>>> varBlocks; // runs of unassigned projection vars with same quantifier: (additive, ddVars)
+  for (Int cnfVar : joinNode->projectionVars) {
+    if (!assignment.contains(cnfVar)) {
+      bool additive = JoinNode::cnf.outerVars.contains(cnfVar);
+      if (existRandom) {
+        additive = !additive;
+      }
+      if (varBlocks.empty() || varBlocks.back().first != additive) { // max and sum do not commute
+        varBlocks.push_back({additive, {}});
+      }
+      varBlocks.back().second.push_back(cnfVarToDdVarMap.at(cnfVar));
+    }
+  }
+  auto isBlockFusible = [maximizerStack](const pair<bool, vector<Int>>& varBlock) {
+    return fusedAbstraction && (varBlock.first || maximizerStack == nullptr); // G_x needs cofactors of whole diagram
+  };
+
+  vector<Dd> factorDds = childDdList;
+  if (earlyProjection && varBlocks.size() == 1 && isBlockFusible(varBlocks.front()) && factorDds.size() > 2) {
+    projectEarly(joinNode, factorDds, varBlocks.front().second, varBlocks.front().first, cnfVarToDdVarMap, mgr, assignment);
+    if (varBlocks.front().second.empty()) {
+      varBlocks.clear();
+    }
+  }
+
+  bool fusing = !varBlocks.empty() && isBlockFusible(varBlocks.front());
+
+  Dd dd = Dd::getOneDd(mgr);
+  Dd lastDd = Dd::getOneDd(mgr); // multiplied by getTimesAbstraction if fusing
+
+  if (ddPackage == SYLVAN && workStealing) {
+    vector<Dd> dds = factorDds;
+    if (fusing && dds.size() > 1) {
+      lastDd = dds.back();
+      dds.pop_back();
+    }
+    dd = getLaceProduct(dds);
+  }
+  else if (joinPriority == ARBITRARY_PAIR) { // arbitrarily multiplies child ADDs
+    for (Int factorIndex = 0; factorIndex < factorDds.size(); factorIndex++) {
+      if (fusing && factorIndex == factorDds.size() - 1) {
+        lastDd = factorDds.at(factorIndex);
+      }
+      else {
+        dd = dd.getProduct(factorDds.at(factorIndex));
+        checkSplitBudget(dd, joinNode);
+      }
+    }
+  }
+  else {
+    multiplyDds(factorDds, fusing ? 2 : 1, joinNode);
+    dd = factorDds.front();
+    if (factorDds.size() > 1) {
+      lastDd = factorDds.at(1);
+    }
+  }
+
+  for (Int blockIndex = 0; blockIndex < varBlocks.size(); blockIndex++) {
+    const pair<bool, vector<Int>>& varBlock = varBlocks.at(blockIndex);
+    const auto& [additive, ddVars] = varBlock;
+    if (fusing && blockIndex == 0) {
+      dd = dd.getTimesAbstraction(lastDd, ddVars, additive, mgr);
+      checkSplitBudget(dd, joinNode);
+    }
+    else if (isBlockFusible(varBlock)) {
+      dd = dd.getWeightedAbstraction(ddVars, additive, mgr);
+      checkSplitBudget(dd, joinNode);
+    }
+    else { // 1 var at a time
+      for (Int ddVar : ddVars) {
+        dd = dd.getAbstraction(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, additive, maximizerStack, mgr);
+        checkSplitBudget(dd, joinNode);
+      }
+    }
+  }
+
+  for (Int cnfVar : joinNode->projectionVars) { // assigned vars only scale dd by constants
+    if (assignment.contains(cnfVar)) {
+      dd = dd.getAbstraction(cnfVarToDdVarMap.at(cnfVar), ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, true, maximizerStack, mgr);
+      checkSplitBudget(dd, joinNode);
+    }
+  }
+
+  updateVarDurations(joinNode, nonterminalStartPoint);
+  updateVarDdSizes(joinNode, dd);
+
+  return dd;
+}
+
+void Executor::projectEarly(const JoinNode* joinNode, vector<Dd>& factorDds, vector<Int>& ddVars, bool additive, const Map<Int, Int>& cnfVarToDdVarMap, const Cudd* mgr, const Assignment& assignment) {
+  assert(factorDds.size() == joinNode->children.size());
+  vector<Set<Int>> factorVarSets; // unassigned ddVars that may appear in factorDds (aligned)
+  for (const JoinNode* child : joinNode->children) {
+    Set<Int> factorVars;
+    for (Int cnfVar : child->getPostProjectionVars()) {
+      if (!assignment.contains(cnfVar)) {
+        factorVars.insert(cnfVarToDdVarMap.at(cnfVar));
+      }
+    }
+    factorVarSets.push_back(factorVars);
+  }
+
+  while (factorDds.size() > 2) {
+    Int bestVar = MIN_INT;
+    Set<Int> bestVars; // of product of bucket of bestVar
+    for (Int ddVar : ddVars) { // bucket with fewest vars goes first
+      Set<Int> bucketVars;
+      Int bucketSize = 0;
+      for (const Set<Int>& factorVars : factorVarSets) {
+        if (factorVars.contains(ddVar)) {
+          bucketVars.insert(factorVars.begin(), factorVars.end());
+          bucketSize++;
+        }
+      }
+      if (bucketSize > 0 && bucketSize < factorDds.size() && (bestVar == MIN_INT || bucketVars.size() < bestVars.size())) {
+        bestVar = ddVar;
+        bestVars = bucketVars;
+      }
+    }
+    if (bestVar == MIN_INT) { // each remaining var is in all factors or none
+      return;
+    }
+
+    vector<Dd> bucketDds;
+    vector<Dd> otherDds;
+    vector<Set<Int>> otherVarSets;
+    for (Int factorIndex = 0; factorIndex < factorDds.size(); factorIndex++) {
+      if (factorVarSets.at(factorIndex).contains(bestVar)) {
+        bucketDds.push_back(factorDds.at(factorIndex));
+      }
+      else {
+        otherDds.push_back(factorDds.at(factorIndex));
+        otherVarSets.push_back(factorVarSets.at(factorIndex));
+      }
+    }
+
+    vector<Int> localVars; // abstracted from product of bucket
+    vector<Int> remainingVars;
+    for (Int ddVar : ddVars) {
+      bool local = bestVars.contains(ddVar);
+      for (const Set<Int>& factorVars : otherVarSets) {
+        local = local && !factorVars.contains(ddVar);
+      }
+      (local ? localVars : remainingVars).push_back(ddVar);
+      if (local) {
+        bestVars.erase(ddVar);
+      }
+    }
+
+    multiplyDds(bucketDds, 2, joinNode);
+    Dd dd = bucketDds.size() == 1 ? bucketDds.front().getWeightedAbstraction(localVars, additive, mgr) : bucketDds.front().getTimesAbstraction(bucketDds.at(1), localVars, additive, mgr);
+    checkSplitBudget(dd, joinNode);
+
+    otherDds.push_back(dd);
+    otherVarSets.push_back(bestVars);
+    factorDds = otherDds;
+    factorVarSets = otherVarSets;
+    ddVars = remainingVars;
+  }
+}
+
+void Executor::multiplyDds(vector<Dd>& dds, Int finalCount, const JoinNode* joinNode) {
+  assert(!dds.empty());
+  if (joinPriority == OVERLAP_PAIR) { // quadratic scan of pairs
+    while (dds.size() > finalCount) {
+      Int bestIndex1 = MIN_INT;
+      Int bestIndex2 = MIN_INT;
+      pair<Int, size_t> bestKey; // (support size of product, sum of sizes)
+      for (Int index1 = 0; index1 < dds.size(); index1++) {
+        for (Int index2 = index1 + 1; index2 < dds.size(); index2++) {
+          pair<Int, size_t> key(Dd::countUnitedVars(dds.at(index1), dds.at(index2)), dds.at(index1).countNodes() + dds.at(index2).countNodes());
+          if (bestIndex1 == MIN_INT || key < bestKey) {
+            bestIndex1 = index1;
+            bestIndex2 = index2;
+            bestKey = key;
+          }
+        }
+      }
+      Dd dd = dds.at(bestIndex1).getProduct(dds.at(bestIndex2));
+      checkSplitBudget(dd, joinNode);
+      dds.erase(dds.begin() + bestIndex2); // bestIndex1 < bestIndex2
+      dds.erase(dds.begin() + bestIndex1);
+      dds.push_back(dd);
+    }
+    std::sort(dds.rbegin(), dds.rend()); // smallest first
+    return;
+  }
+
+  std::priority_queue<Dd> ddQueue; // Dd::operator< handles both biggest-first and smallest-first
+  for (const Dd& dd : dds) {
+    ddQueue.push(dd);
+  }
+  while (ddQueue.size() > finalCount) {
+    Dd dd1 = ddQueue.top();
+    ddQueue.pop();
+    Dd dd2 = ddQueue.top();
+    ddQueue.pop();
+    Dd dd3 = dd1.getProduct(dd2);
+    checkSplitBudget(dd3, joinNode);
+    ddQueue.push(dd3);
+  }
+  dds.clear();
+  while (!ddQueue.empty()) {
+    dds.push_back(ddQueue.top());
+    ddQueue.pop();
+  }
+}
+
+void Executor::benchmarkJoinPriorities(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  string chosenPriority = joinPriority;
+  for (const auto& [priority, priorityName] : JOIN_PRIORITIES) {
+    joinPriority = priority; // global var
+    maxDdSize = 0;
+    TimePoint benchmarkStartPoint = util::getTimePoint();
+    Number n = solveCnf(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+    util::printRow("benchmarkSeconds_" + priorityName, util::getDuration(benchmarkStartPoint));
+    util::printRow("benchmarkMaxDiagramSize_" + priorityName, maxDdSize);
+    util::printRow("benchmarkSolution_" + priorityName, logCounting ? exp10l(n.fraction) : n);
+  }
+  joinPriority = chosenPriority;
+}
+
+vector<pair<Int, Dd>>* Executor::getKeptMaximizerStack() {
+  return maximizingAssignment && !recomputingMaximizer ? &maximizerStack : nullptr;
+}
+
+Dd Executor::getLaceProduct(vector<Dd> dds) {
+  LACE_ME;
+  assert(!dds.empty());
+  while (dds.size() > 1) { // each round multiplies disjoint pairs in parallel
+    if (joinPriority != ARBITRARY_PAIR) { // pairs diagrams of similar sizes, preferred pairs first
+      std::sort(dds.begin(), dds.end());
+    }
+    Int pairCount = dds.size() / 2;
+    for (Int pairIndex = 1; pairIndex < pairCount; pairIndex++) {
+      mtbdd_refs_spawn(SPAWN(laceGetProduct, dds.at(dds.size() - 2 * pairIndex - 1).mtbdd.GetMTBDD(), dds.at(dds.size() - 2 * pairIndex - 2).mtbdd.GetMTBDD()));
+    }
+    vector<Dd> products;
+    products.push_back(Dd(Mtbdd(CALL(laceGetProduct, dds.at(dds.size() - 1).mtbdd.GetMTBDD(), dds.at(dds.size() - 2).mtbdd.GetMTBDD()))));
+    for (Int pairIndex = 1; pairIndex < pairCount; pairIndex++) {
+      products.push_back(Dd(Mtbdd(mtbdd_refs_sync(SYNC(laceGetProduct)))));
+    }
+    if (dds.size() % 2 == 1) { // least preferred diagram waits for next round
+      products.push_back(dds.front());
+    }
+    dds = products;
+  }
+  return dds.front();
+}
+
+Int Executor::getSplitVar(const JoinNode* joinNode, const JoinNode* failedNode, const Assignment& assignment) {
+  std::queue<const JoinNode*> q;
+  q.push(joinNode);
+  while (!q.empty()) {
+    const JoinNode* n = q.front();
+    q.pop();
+    for (Int var : n->projectionVars) {
+      if (JoinNode::cnf.outerVars.contains(var) && !assignment.contains(var) && failedNode->preProjectionVars.contains(var)) {
+        return var;
+      }
+    }
+    for (const JoinNode* child : n->children) {
+      if (!child->isTerminal()) {
+        q.push(child);
+      }
+    }
+  }
+  return MIN_INT;
+}
+
+Dd Executor::solveSplitSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment, SubtreeMemo* subtreeMemo) {
+  const JoinNode* failedNode = joinNode;
+  bool memExceeded = false;
+  try {
+    return solveSubtree(joinNode, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo);
+  }
+  catch (const SplitException& e) {
+    failedNode = e.joinNode;
+    memExceeded = e.memExceeded;
+  }
+  catch (const std::logic_error&) { // thrown by CUDD on max mem
+    Cudd_ClearErrorCode(mgr->getManager());
+    memExceeded = true;
+  }
+
+  Int splitVar = getSplitVar(joinNode, failedNode, assignment); // graded join tree: vars projected above it in subtree have same quantifier
+  if (splitVar == MIN_INT) { // lets ancestor split on outer var of failedNode projected above joinNode
+    throw SplitException(failedNode, memExceeded);
+  }
+  splitCount++;
+
+  Assignment assignment0 = assignment;
+  assignment0.assign(splitVar, false);
+  Assignment assignment1 = assignment;
+  assignment1.assign(splitVar, true);
+  Dd dd0 = solveSplitSubtree(joinNode, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment0, nullptr); // memo is keyed by slice vars only
+  Dd dd1 = solveSplitSubtree(joinNode, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment1, nullptr);
+  return existRandom ? dd0.getMax(dd1) : dd0.getSum(dd1); // outer var
+}
+
+Dd Executor::solveRootSubtree(const JoinNode* root, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment, SubtreeMemo* subtreeMemo) {
+  if (splitBudget == 0) {
+    return solveSubtree(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo);
+  }
+  try {
+    return solveSplitSubtree(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo);
+  }
+  catch (const SplitException& e) { // no outer var left to split anywhere in tree
+    if (e.memExceeded) {
+      throw MyError("max mem exceeded at join node ", e.joinNode->nodeIndex + 1, " with no outer var left to split");
+    }
+  }
+
+  struct BudgetSuspension { // also for descendants, until solve returns or throws
+    BudgetSuspension() { splitBudgetSuspended = true; }
+    ~BudgetSuspension() { splitBudgetSuspended = false; }
+  } budgetSuspension;
+  try {
+    return solveSubtree(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo);
+  }
+  catch (const std::logic_error&) { // thrown by CUDD on max mem
+    throw MyError("max mem exceeded with split budget suspended");
+  }
+}
+
+Dd Executor::solveSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment, SubtreeMemo* subtreeMemo) {
+  if (joinNode->isTerminal()) {
+    TimePoint terminalStartPoint = util::getTimePoint();
+
+    Dd d = getClauseDd(cnfVarToDdVarMap, joinNode->nodeIndex, mgr, assignment);
+
+    updateVarDurations(joinNode, terminalStartPoint);
+    updateVarDdSizes(joinNode, d);
+
+    return d;
+  }
+
+  Map<Int, Dd>* memoDds = nullptr;
+  Int memoKey = 0;
+  if (subtreeMemo != nullptr && memoNodeMasks.contains(joinNode->nodeIndex)) {
+    memoDds = &subtreeMemo->subtreeDds[joinNode->nodeIndex];
+    memoKey = subtreeMemo->sliceMask & memoNodeMasks.at(joinNode->nodeIndex);
+    auto it = memoDds->find(memoKey);
+    if (it != memoDds->end()) {
+      subtreeMemo->hitCount++;
+      return it->second;
+    }
+  }
+
+  vector<Dd> childDdList;
+  for (JoinNode* child : joinNode->children) {
+    childDdList.push_back(splitBudget > 0 && !splitBudgetSuspended ? solveSplitSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo) : solveSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, subtreeMemo));
+  }
+
+  Dd dd = joinChildDds(joinNode, childDdList, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, getKeptMaximizerStack());
+  if (memoDds != nullptr) {
+    memoDds->insert({memoKey, dd});
+  }
+  return dd;
+}
+
+void Executor::evictSubtreeMemo(SubtreeMemo* memo, const vector<Assignment>& assignments, Int nextAssignmentIndex, Int blockEnd) {
+  vector<Int> nextSliceMasks;
+  for (Int assignmentIndex = nextAssignmentIndex; assignmentIndex < blockEnd; assignmentIndex++) {
+    nextSliceMasks.push_back(getSliceMask(assignments.at(assignmentIndex)));
+  }
+  for (auto& [nodeIndex, memoDds] : memo->subtreeDds) {
+    Int nodeMask = memoNodeMasks.at(nodeIndex);
+    for (auto it = memoDds.begin(); it != memoDds.end();) {
+      bool recurs = false;
+      for (Int sliceMask : nextSliceMasks) {
+        if ((sliceMask & nodeMask) == it->first) {
+          recurs = true;
+          break;
+        }
+      }
+      it = recurs ? std::next(it) : memoDds.erase(it);
+    }
+  }
+}
+
+void Executor::solveThreadSlices(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Float threadMem, Int threadIndex, const vector<Assignment>& assignments, std::atomic<Int>& nextAssignmentIndex, Int blockSize, vector<Number>& sliceSolutions, mutex& solutionMutex, Float& busyDuration) {
+  busyDuration = 0;
+  const Cudd* mgr = ddPackage == CUDD ? Dd::newMgr(threadMem, threadIndex) : nullptr; // reused by all slices of this thread
+  SubtreeMemo* memo = subtreeMemo ? new SubtreeMemo() : nullptr; // references mgr
+  vector<pair<Int, Dd>> bestMaximizerStack; // of best slice so far
+  Int bestAssignmentIndex = MIN_INT;
+  for (Int blockBegin = nextAssignmentIndex.fetch_add(blockSize); blockBegin < assignments.size(); blockBegin = nextAssignmentIndex.fetch_add(blockSize)) {
+    Int blockEnd = min(blockBegin + blockSize, static_cast<Int>(assignments.size()));
+    for (Int assignmentIndex = blockBegin; assignmentIndex < blockEnd; assignmentIndex++) {
+      if (sliceJournal != nullptr && sliceJournal->sliceSolutions.contains(assignmentIndex)) { // solved before restart
+        continue;
+      }
+      TimePoint sliceStartPoint = util::getTimePoint();
+
+      Assignment assignment = assignments.at(assignmentIndex);
+      assignment.densify(); // per-literal lookups in clause and abstraction diagrams
+      if (memo != nullptr) {
+        memo->sliceMask = getSliceMask(assignment);
+      }
+      const JoinNode* root = static_cast<const JoinNode*>(joinRoot);
+      Number partialSolution = solveRootSubtree(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, memo).extractConst();
+      if (memo != nullptr) {
+        evictSubtreeMemo(memo, assignments, assignmentIndex + 1, blockEnd);
+      }
+      if (ddPackage == CUDD) {
+        cuddGarbageCollect(mgr->getManager(), 1); // frees dead nodes of this slice and their cache entries but keeps live cache entries
+      }
+
+      Float sliceDuration = util::getDuration(sliceStartPoint);
+      busyDuration += sliceDuration;
+
+      const std::lock_guard<mutex> g(solutionMutex);
+
+      if (verboseSolving >= 1) {
+        cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << min(threadCount, static_cast<Int>(assignments.size())) << " | assignment " << setw(4) << assignmentIndex + 1 << "/" << assignments.size() << ": { ";
+        assignments.at(assignmentIndex).printAssignment();
+        cout << " }\n";
+
+        cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << min(threadCount, static_cast<Int>(assignments.size())) << " | assignment " << setw(4) << assignmentIndex + 1 << "/" << assignments.size() << " | seconds " << left << setw(10) << sliceDuration << " | mc " << setw(15);
+        if (logCounting) {
+          cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
+        }
+        else {
+          cout << partialSolution << "\n";
+        }
+      }
+
+      sliceSolutions.at(assignmentIndex) = partialSolution;
+      if (sliceJournal != nullptr) {
+        sliceJournal->recordSlice(assignmentIndex, assignments.at(assignmentIndex), partialSolution);
+      }
+
+      if (maximizingAssignment) { // sliced outer vars are maximized across slices, so only G_x diagrams of best slice are kept
+        if (bestAssignmentIndex == MIN_INT || sliceSolutions.at(bestAssignmentIndex) < partialSolution) {
+          bestMaximizerStack.swap(maximizerStack);
+          bestAssignmentIndex = assignmentIndex;
+        }
+        maximizerStack.clear();
+      }
+    }
+  }
+  if (bestAssignmentIndex != MIN_INT) {
+    const std::lock_guard<mutex> g(solutionMutex);
+    sliceMaximizerStacks[bestAssignmentIndex].swap(bestMaximizerStack);
+  }
+
+  if (memo != nullptr) {
+    if (verboseSolving >= 1) {
+      const std::lock_guard<mutex> g(solutionMutex);
+      util::printRow("threadMemoHits_" + to_string(threadIndex + 1), memo->hitCount);
+    }
+    delete memo; // before mgr
+  }
+
+  releaseClauseDds();
+  if (getKeptMaximizerStack() == nullptr) { // Executor::sliceMaximizerStacks still references mgr otherwise
+    delete mgr;
+  }
+}
+
+void Executor::runWorkerProcess(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Float processMem, Int processIndex, const vector<Assignment>& assignments, int writeFd) {
+  const Cudd* mgr = Dd::newMgr(processMem, processIndex);
+  const JoinNode* root = static_cast<const JoinNode*>(joinRoot);
+  for (Int assignmentIndex = 0; assignmentIndex < assignments.size(); assignmentIndex++) {
+    Assignment assignment = assignments.at(assignmentIndex);
+    assignment.densify();
+    Number partialSolution = solveRootSubtree(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, nullptr).extractConst();
+    cuddGarbageCollect(mgr->getManager(), 1);
+
+    string line = to_string(assignmentIndex) + " " + partialSolution.getExactString() + "\n";
+    if (write(writeFd, line.data(), line.size()) != line.size()) {
+      _exit(EXIT_FAILURE);
+    }
+  }
+  close(writeFd);
+  _exit(EXIT_SUCCESS); // skips destructors and stdio buffers shared with parent
+}
+
+vector<Assignment> Executor::resliceAssignment(const Assignment& assignment, const vector<Int>& sliceVarOrder) {
+  for (Int var : sliceVarOrder) { // outer vars come first
+    if (!assignment.contains(var)) {
+      return Assignment::extendAssignments(vector<Assignment>{assignment}, var);
+    }
+  }
+  throw MyError("failed slice has no unassigned var left");
+}
+
+Number Executor::solveWorkerProcesses(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  vector<Assignment> sliceAssignments = getSliceAssignments(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+  std::deque<Assignment> pendingAssignments(sliceAssignments.begin(), sliceAssignments.end());
+  vector<Int> sliceVarOrder = joinRoot->getSliceVarOrder(sliceVarOrderHeuristic);
+
+  Float processMem = maxMem / threadCount;
+  util::printRow("processMaxMemMegabytes", processMem);
+
+  vector<Assignment> solvedAssignments; // resliced slices replace failed ones
+  vector<Number> sliceSolutions;
+  Int resliceCount = 0;
+  Int processIndex = 0;
+  vector<WorkerProcess> workers;
+  while (!pendingAssignments.empty() || !workers.empty()) {
+    while (workers.size() < threadCount && !pendingAssignments.empty()) {
+      WorkerProcess worker;
+      Int batchSize = ceill(static_cast<Float>(pendingAssignments.size()) / (threadCount - workers.size()));
+      for (Int i = 0; i < batchSize; i++) {
+        worker.assignments.push_back(pendingAssignments.front());
+        pendingAssignments.pop_front();
+      }
+
+      int fds[2];
+      if (pipe(fds) != 0) {
+        throw MyError("failed to create pipe for worker process");
+      }
+      cout << std::flush; // else child would repeat buffered output
+      worker.pid = fork();
+      if (worker.pid < 0) {
+        throw MyError("failed to fork worker process");
+      }
+      if (worker.pid == 0) {
+        close(fds[0]);
+        runWorkerProcess(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, processMem, processIndex, worker.assignments, fds[1]);
+      }
+      close(fds[1]);
+      worker.readFd = fds[0];
+      processIndex++;
+      workers.push_back(worker);
+    }
+
+    vector<pollfd> pollFds;
+    for (const WorkerProcess& worker : workers) {
+      pollFds.push_back({worker.readFd, POLLIN, 0});
+    }
+    poll(pollFds.data(), pollFds.size(), -1);
+
+    for (Int workerIndex = workers.size() - 1; workerIndex >= 0; workerIndex--) { // backward for erasing
+      if (pollFds.at(workerIndex).revents == 0) {
+        continue;
+      }
+      WorkerProcess& worker = workers.at(workerIndex);
+
+      vector<string> lines;
+      if (readLines(worker.readFd, worker.buffer, lines)) {
+        for (const string& lineString : lines) {
+          std::istringstream line(lineString);
+          Int assignmentIndex;
+          string numberString;
+          line >> assignmentIndex >> numberString;
+          assert(assignmentIndex == worker.solvedCount);
+          Number partialSolution(numberString);
+          worker.solvedCount++;
+
+          if (verboseSolving >= 1) {
+            cout << "c process " << right << setw(6) << worker.pid << " | assignment " << setw(4) << assignmentIndex + 1 << "/" << worker.assignments.size() << ": { ";
+            worker.assignments.at(assignmentIndex).printAssignment();
+            cout << " } | mc " << left << setw(15);
+            if (logCounting) {
+              cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
+            }
+            else {
+              cout << partialSolution << "\n";
+            }
+          }
+
+          solvedAssignments.push_back(worker.assignments.at(assignmentIndex));
+          sliceSolutions.push_back(partialSolution);
+        }
+        continue;
+      }
+
+      close(worker.readFd); // worker exited or crashed
+      int status;
+      waitpid(worker.pid, &status, 0);
+      if (worker.solvedCount < worker.assignments.size()) {
+        cout << WARNING << "worker process " << worker.pid << " failed on assignment " << worker.solvedCount + 1 << "/" << worker.assignments.size() << "; reslicing\n";
+        for (Int i = worker.assignments.size() - 1; i > worker.solvedCount; i--) { // unsolved slices keep their order
+          pendingAssignments.push_front(worker.assignments.at(i));
+        }
+        for (const Assignment& assignment : resliceAssignment(worker.assignments.at(worker.solvedCount), sliceVarOrder)) {
+          pendingAssignments.push_back(assignment);
+        }
+        resliceCount++;
+      }
+      workers.erase(workers.begin() + workerIndex);
+    }
+  }
+
+  util::printRow("solvedSliceCount", solvedAssignments.size());
+  util::printRow("resliceCount", resliceCount);
+  return getSliceFold(solvedAssignments, sliceSolutions);
+}
+
+bool Executor::readLines(int fd, string& buffer, vector<string>& lines) {
+  lines.clear();
+  char chunk[4096];
+  ssize_t chunkSize = read(fd, chunk, sizeof(chunk));
+  if (chunkSize <= 0) {
+    return false;
+  }
+  buffer.append(chunk, chunkSize);
+  for (size_t lineEnd = buffer.find('\n'); lineEnd != string::npos; lineEnd = buffer.find('\n')) {
+    lines.push_back(buffer.substr(0, lineEnd));
+    buffer.erase(0, lineEnd + 1);
+  }
+  return true;
+}
+
+bool Executor::sendLine(int fd, const string& line) {
+  string message = line + "\n";
+  for (size_t sentSize = 0; sentSize < message.size();) {
+    ssize_t chunkSize = send(fd, message.data() + sentSize, message.size() - sentSize, MSG_NOSIGNAL); // broken connection is detected by reader
+    if (chunkSize <= 0) {
+      return false;
+    }
+    sentSize += chunkSize;
+  }
+  return true;
+}
+
+bool Executor::hasUnixAddress() {
+  return clusterAddress.find('/') != string::npos || clusterAddress.find(':') == string::npos;
+}
+
+int Executor::openSocket(int family, const sockaddr* address, socklen_t addressLength, bool listening) {
+  TimePoint startPoint = util::getTimePoint();
+  while (true) {
+    int fd = socket(family, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw MyError("failed to create socket for ", clusterAddress);
+    }
+
+    if (listening) {
+      if (family == AF_UNIX) {
+        unlink(clusterAddress.c_str()); // socket file of previous run
+      }
+      else {
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+      }
+      if (bind(fd, address, addressLength) != 0 || listen(fd, SOMAXCONN) != 0) {
+        throw MyError("failed to listen on ", clusterAddress);
+      }
+      return fd;
+    }
+
+    if (connect(fd, address, addressLength) == 0) {
+      return fd;
+    }
+    close(fd);
+    if (util::getDuration(startPoint) > CONNECT_RETRY_DURATION) {
+      throw MyError("failed to connect to ", clusterAddress);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}
+
+int Executor::getClusterSocket(bool listening) {
+  if (hasUnixAddress()) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (clusterAddress.size() >= sizeof(address.sun_path)) {
+      throw MyError("Unix socket path too long: ", clusterAddress);
+    }
+    clusterAddress.copy(address.sun_path, clusterAddress.size());
+    return openSocket(AF_UNIX, reinterpret_cast<const sockaddr*>(&address), sizeof(address), listening);
+  }
+
+  size_t colonPos = clusterAddress.rfind(':');
+  string host = clusterAddress.substr(0, colonPos);
+  string port = clusterAddress.substr(colonPos + 1);
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = listening ? AI_PASSIVE : 0;
+  addrinfo* addresses;
+  if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &addresses) != 0) {
+    throw MyError("failed to resolve ", clusterAddress);
+  }
+  int fd = openSocket(addresses->ai_family, addresses->ai_addr, addresses->ai_addrlen, listening);
+  freeaddrinfo(addresses);
+  return fd;
+}
+
+vector<Int> Executor::getSliceLiterals(const Assignment& assignment) {
+  Set<Int> vars;
+  for (const auto& [var, val] : assignment) {
+    vars.insert(var);
+  }
+  vector<Int> literals;
+  for (Int var : util::getSortedNums(vars)) {
+    literals.push_back(assignment.at(var) ? var : -var);
+  }
+  return literals;
+}
+
+size_t Executor::getSliceHash(const vector<Assignment>& assignments) {
+  size_t hash = FNV_OFFSET_BASIS;
+  for (const Assignment& assignment : assignments) {
+    util::updateFnvHash(hash, 0); // separates assignments
+    for (Int literal : getSliceLiterals(assignment)) {
+      util::updateFnvHash(hash, literal);
+    }
+  }
+  return hash;
+}
+
+size_t Executor::getRunHash(const JoinNonterminal* joinRoot, const vector<Assignment>& assignments) {
+  size_t hash = JoinNode::cnf.getHash();
+  joinRoot->updateSubtreeHash(hash);
+  for (bool option : {weightedCounting, projectedCounting, existRandom, logCounting, multiplePrecision}) {
+    util::updateFnvHash(hash, option);
+  }
+  util::updateFnvHash(hash, static_cast<Int>(getSliceHash(assignments)));
+  return hash;
+}
+
+bool Executor::giveClusterRange(ClusterConnection& connection, std::deque<pair<Int, Int>>& pendingRanges, Int& nextSliceIndex, Int sliceCount, Int connectionCount) {
+  if (!pendingRanges.empty()) { // requeued by disconnected worker
+    connection.rangeBegin = pendingRanges.front().first;
+    connection.rangeEnd = pendingRanges.front().second;
+    pendingRanges.pop_front();
+  }
+  else if (nextSliceIndex < sliceCount) {
+    Int rangeSize = max(1LL, (sliceCount - nextSliceIndex) / (2 * connectionCount)); // ranges shrink as slices run out
+    connection.rangeBegin = nextSliceIndex;
+    connection.rangeEnd = min(sliceCount, nextSliceIndex + rangeSize);
+    nextSliceIndex = connection.rangeEnd;
+  }
+  else {
+    return false;
+  }
+  sendLine(connection.fd, "range " + to_string(connection.rangeBegin) + " " + to_string(connection.rangeEnd)); // failure is requeued on EOF
+  return true;
+}
+
+Number Executor::solveCoordinator(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  vector<Assignment> assignments = getSliceAssignments(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+  Int sliceCount = assignments.size();
+  size_t runHash = getRunHash(joinRoot, assignments);
+
+  int listenFd = getClusterSocket(true);
+
+  vector<Number> sliceSolutions(sliceCount);
+  Int solvedSliceCount = 0;
+  Int nextSliceIndex = 0;
+  Int clusterWorkerCount = 0;
+  Int requeuedRangeCount = 0;
+  std::deque<pair<Int, Int>> pendingRanges; // [begin, end) of slice indices
+  vector<ClusterConnection> connections;
+  while (solvedSliceCount < sliceCount) {
+    vector<pollfd> pollFds{{listenFd, POLLIN, 0}};
+    for (const ClusterConnection& connection : connections) {
+      pollFds.push_back({connection.fd, POLLIN, 0});
+    }
+    poll(pollFds.data(), pollFds.size(), -1);
+
+    for (Int connectionIndex = connections.size() - 1; connectionIndex >= 0; connectionIndex--) { // backward for erasing
+      if (pollFds.at(connectionIndex + 1).revents == 0) {
+        continue;
+      }
+      ClusterConnection& connection = connections.at(connectionIndex);
+
+      vector<string> lines;
+      bool dropped = !readLines(connection.fd, connection.buffer, lines);
+      for (const string& lineString : lines) {
+        if (dropped) {
+          break;
+        }
+        std::istringstream line(lineString);
+        string word;
+        line >> word;
+        if (word == "hello") {
+          Int workerSliceCount = MIN_INT;
+          size_t workerRunHash = 0;
+          line >> workerSliceCount >> workerRunHash;
+          if (!line || workerSliceCount != sliceCount || workerRunHash != runHash) {
+            cout << WARNING << "worker has different cnf, join tree, options, or slices; rejecting\n";
+            sendLine(connection.fd, "reject");
+          }
+          else {
+            connection.greeted = true;
+          }
+        }
+        else if (word == "solution") {
+          Int rangeBegin = MIN_INT;
+          Int rangeEnd = MIN_INT;
+          line >> rangeBegin >> rangeEnd;
+          vector<Number> rangeSolutions;
+          if (line && connection.rangeBegin != MIN_INT && rangeBegin == connection.rangeBegin && rangeEnd == connection.rangeEnd) {
+            try {
+              for (Int assignmentIndex = rangeBegin; assignmentIndex < rangeEnd; assignmentIndex++) {
+                string numberString;
+                line >> numberString;
+                rangeSolutions.push_back(Number(numberString));
+              }
+            }
+            catch (const std::logic_error&) { // invalid_argument or out_of_range from number parsing
+              rangeSolutions.clear();
+            }
+          }
+          if (rangeSolutions.size() != rangeEnd - rangeBegin || rangeSolutions.empty()) {
+            cout << WARNING << "worker sent malformed solution line; dropping connection\n";
+            dropped = true;
+            break;
+          }
+          for (Int assignmentIndex = rangeBegin; assignmentIndex < rangeEnd; assignmentIndex++) {
+            Number partialSolution = rangeSolutions.at(assignmentIndex - rangeBegin);
+            sliceSolutions.at(assignmentIndex) = partialSolution;
+
+            if (verboseSolving >= 1) {
+              cout << "c coordinator | assignment " << right << setw(4) << assignmentIndex + 1 << "/" << sliceCount << " | mc " << left << setw(15);
+              if (logCounting) {
+                cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
+              }
+              else {
+                cout << partialSolution << "\n";
+              }
+            }
+          }
+          solvedSliceCount += rangeEnd - rangeBegin;
+          connection.rangeBegin = MIN_INT;
+        }
+      }
+      if (dropped) { // disconnected or malformed message
+        close(connection.fd);
+        if (connection.rangeBegin != MIN_INT) {
+          cout << WARNING << "worker dropped while solving slices " << connection.rangeBegin + 1 << "-" << connection.rangeEnd << "/" << sliceCount << "; requeuing\n";
+          pendingRanges.push_back({connection.rangeBegin, connection.rangeEnd});
+          requeuedRangeCount++;
+        }
+        connections.erase(connections.begin() + connectionIndex);
+      }
+    }
+
+    if (pollFds.front().revents != 0) {
+      int fd = accept(listenFd, nullptr, nullptr);
+      if (fd >= 0) {
+        ClusterConnection connection;
+        connection.fd = fd;
+        connections.push_back(connection);
+        clusterWorkerCount++;
+      }
+    }
+
+    for (ClusterConnection& connection : connections) { // idle workers also pick up requeued ranges
+      if (connection.greeted && connection.rangeBegin == MIN_INT) {
+        giveClusterRange(connection, pendingRanges, nextSliceIndex, sliceCount, connections.size());
+      }
+    }
+  }
+
+  Number totalSolution = getSliceFold(assignments, sliceSolutions);
+  for (const ClusterConnection& connection : connections) {
+    sendLine(connection.fd, "quit " + totalSolution.getExactString());
+    close(connection.fd);
+  }
+  close(listenFd);
+  if (hasUnixAddress()) {
+    unlink(clusterAddress.c_str());
+  }
+
+  util::printRow("clusterWorkerCount", clusterWorkerCount);
+  util::printRow("requeuedRangeCount", requeuedRangeCount);
+  return totalSolution;
+}
+
+Number Executor::solveClusterWorker(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  vector<Assignment> assignments = getSliceAssignments(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic); // same as coordinator's
+  int fd = getClusterSocket(false);
+  sendLine(fd, "hello " + to_string(assignments.size()) + " " + to_string(getRunHash(joinRoot, assignments)));
+
+  Int solvedSliceCount = 0;
+  string buffer;
+  vector<string> lines;
+  while (readLines(fd, buffer, lines)) {
+    for (const string& lineString : lines) {
+      std::istringstream line(lineString);
+      string word;
+      line >> word;
+      if (word == "range") {
+        Int rangeBegin;
+        Int rangeEnd;
+        line >> rangeBegin >> rangeEnd;
+        vector<Assignment> rangeAssignments(assignments.begin() + rangeBegin, assignments.begin() + rangeEnd);
+        string solutionLine = "solution " + to_string(rangeBegin) + " " + to_string(rangeEnd);
+        for (const Number& partialSolution : solveSliceThreads(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, rangeAssignments)) {
+          solutionLine += " " + partialSolution.getExactString();
+        }
+        sendLine(fd, solutionLine);
+        solvedSliceCount += rangeEnd - rangeBegin;
+      }
+      else if (word == "reject") {
+        throw MyError("coordinator has different run (cnf, join tree, counting options, and slices must match)");
+      }
+      else if (word == "quit") {
+        string numberString;
+        line >> numberString;
+        close(fd);
+        util::printRow("workerSolvedSliceCount", solvedSliceCount);
+        return Number(numberString);
+      }
+    }
+  }
+  throw MyError("coordinator closed connection");
+}
+
+SubtreeTask* Executor::getSubtreeTask(const JoinNode* joinNode, std::deque<SubtreeTask>& tasks) {
+  SubtreeTask& task = tasks.emplace_back(); // deque never relocates tasks
+  task.joinNode = joinNode;
+  for (const JoinNode* child : joinNode->children) {
+    if (child->isTerminal()) {
+      task.childTasks.push_back(nullptr);
+    }
+    else {
+      SubtreeTask* childTask = getSubtreeTask(child, tasks);
+      childTask->parentTask = &task;
+      task.childTasks.push_back(childTask);
+      task.pendingChildCount++;
+    }
+  }
+  return &task;
+}
+
+SubtreeTask* Executor::popSubtreeTask(vector<SubtreeWorker>& workers, Int workerIndex) {
+  for (Int i = 0; i < workers.size(); i++) { // tries own deque first
+    SubtreeWorker& worker = workers.at((workerIndex + i) % workers.size());
+    const std::lock_guard<mutex> g(worker.workerMutex);
+    if (!worker.readyTasks.empty()) {
+      SubtreeTask* task;
+      if (i == 0) { // most recent task (likely to reuse own manager)
+        task = worker.readyTasks.back();
+        worker.readyTasks.pop_back();
+      }
+      else { // oldest task (likely to be biggest)
+        task = worker.readyTasks.front();
+        worker.readyTasks.pop_front();
+      }
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+void Executor::releaseAdds(SubtreeWorker& worker) {
+  vector<ADD*> adds;
+  {
+    const std::lock_guard<mutex> g(worker.workerMutex);
+    adds.swap(worker.releasedAdds);
+  }
+  for (ADD* add : adds) { // dereferences in owner thread
+    delete add;
+  }
+}
+
+void Executor::solveSubtreeTask(SubtreeTask* task, vector<SubtreeWorker>& workers, Int workerIndex, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, TaskSignal& taskSignal) {
+  const Cudd* mgr = workers.at(workerIndex).mgr;
+
+  vector<Dd> childDdList;
+  for (Int childIndex = 0; childIndex < task->childTasks.size(); childIndex++) {
+    SubtreeTask* childTask = task->childTasks.at(childIndex);
+    if (childTask == nullptr) {
+      childDdList.push_back(solveSubtree(task->joinNode->children.at(childIndex), cnfVarToDdVarMap, ddVarToCnfVarMap, mgr));
+    }
+    else if (childTask->workerIndex == workerIndex) {
+      childDdList.push_back(Dd(*childTask->cuadd));
+      delete childTask->cuadd;
+    }
+    else { // only reads manager of other worker (see Cudd_addTransfer)
+      childDdList.push_back(Dd::getTransfer(*childTask->cuadd, mgr));
+      SubtreeWorker& owner = workers.at(childTask->workerIndex);
+      const std::lock_guard<mutex> g(owner.workerMutex);
+      owner.releasedAdds.push_back(childTask->cuadd);
+    }
+  }
+
+  Dd dd = joinChildDds(task->joinNode, childDdList, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, Assignment(), getKeptMaximizerStack());
+  task->cuadd = new ADD(dd.cuadd);
+  task->maximizerStack.swap(maximizerStack); // leaves stack of this thread empty
+  task->workerIndex = workerIndex;
+
+  SubtreeTask* parentTask = task->parentTask;
+  if (parentTask != nullptr && --parentTask->pendingChildCount == 0) { // last child readies parent
+    SubtreeWorker& worker = workers.at(workerIndex);
+    {
+      const std::lock_guard<mutex> g(worker.workerMutex);
+      worker.readyTasks.push_back(parentTask);
+    }
+    const std::lock_guard<mutex> g(taskSignal.signalMutex);
+    taskSignal.readiedTaskCount++;
+    taskSignal.readyCondition.notify_one();
+  }
+}
+
+void Executor::runSubtreeWorker(vector<SubtreeWorker>& workers, Int workerIndex, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, TaskSignal& taskSignal) {
+  while (true) {
+    releaseAdds(workers.at(workerIndex));
+    Int readiedTaskCount;
+    {
+      const std::lock_guard<mutex> g(taskSignal.signalMutex);
+      if (taskSignal.rootDone) {
+        break;
+      }
+      readiedTaskCount = taskSignal.readiedTaskCount; // before popping, so a task readied meanwhile is not missed
+    }
+    SubtreeTask* task = popSubtreeTask(workers, workerIndex);
+    if (task == nullptr) {
+      std::unique_lock<mutex> l(taskSignal.signalMutex);
+      taskSignal.readyCondition.wait(l, [&] { return taskSignal.rootDone || taskSignal.readiedTaskCount != readiedTaskCount; });
+    }
+    else {
+      solveSubtreeTask(task, workers, workerIndex, cnfVarToDdVarMap, ddVarToCnfVarMap, taskSignal);
+      if (task->parentTask == nullptr) {
+        const std::lock_guard<mutex> g(taskSignal.signalMutex);
+        taskSignal.rootDone = true;
+        taskSignal.readyCondition.notify_all();
+      }
+    }
+  }
+  releaseClauseDds(); // before mgr of this worker is deleted
+}
+
+Number Executor::solveWorkStealing(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap) {
+  std::deque<SubtreeTask> tasks;
+  SubtreeTask* rootTask = getSubtreeTask(joinRoot, tasks);
+  util::printRow("subtreeTaskCount", tasks.size());
+
+  Float threadMem = maxMem / threadCount;
+  util::printRow("threadMaxMemMegabytes", threadMem);
+
+  vector<SubtreeWorker> workers(threadCount);
+  for (Int workerIndex = 0; workerIndex < workers.size(); workerIndex++) {
+    workers.at(workerIndex).mgr = Dd::newMgr(threadMem, workerIndex);
+  }
+
+  Int readyTaskCount = 0;
+  for (SubtreeTask& task : tasks) { // deals leaf tasks round-robin
+    if (task.pendingChildCount == 0) {
+      workers.at(readyTaskCount++ % workers.size()).readyTasks.push_back(&task);
+    }
+  }
+
+  TaskSignal taskSignal;
+  vector<thread> threads;
+  for (Int workerIndex = 1; workerIndex < workers.size(); workerIndex++) {
+    threads.push_back(thread(
+      runSubtreeWorker,
+      std::ref(workers),
+      workerIndex,
+      std::cref(cnfVarToDdVarMap),
+      std::cref(ddVarToCnfVarMap),
+      std::ref(taskSignal)
+    ));
+  }
+  runSubtreeWorker(workers, 0, cnfVarToDdVarMap, ddVarToCnfVarMap, taskSignal); // main thread is worker 0
+  for (thread& t : threads) {
+    t.join();
+  }
+
+  for (SubtreeWorker& worker : workers) {
+    releaseAdds(worker);
+  }
+  Number solution = Dd(*rootTask->cuadd).extractConst();
+  delete rootTask->cuadd;
+
+  for (auto it = tasks.rbegin(); it != tasks.rend(); it++) { // tasks are in pre-order, so descendants are stacked before ancestors
+    maximizerStack.insert(maximizerStack.end(), it->maximizerStack.begin(), it->maximizerStack.end());
+  }
+
+  if (getKeptMaximizerStack() == nullptr) { // Executor::maximizerStack still references managers otherwise
+    for (SubtreeWorker& worker : workers) {
+      delete worker.mgr;
+    }
+  }
+  return solution;
+}
+
+void Executor::updateSliceCost(const JoinNode* joinNode, const Set<Int>& costSliceVars, Map<Int, Float>& varCostGains, Float& sliceCost, Int& sliceWidth) {
+  if (joinNode->isTerminal()) { // clause vars also appear in parent
+    return;
+  }
+
+  Set<Int> vars = util::getDiff(joinNode->preProjectionVars, costSliceVars);
+  Float nodeCost = exp2l(vars.size());
+  sliceCost += nodeCost;
+  sliceWidth = max(sliceWidth, static_cast<Int>(vars.size()));
+  for (Int var : vars) {
+    varCostGains[var] += nodeCost / 2;
+  }
+
+  for (const JoinNode* child : joinNode->children) {
+    updateSliceCost(child, costSliceVars, varCostGains, sliceCost, sliceWidth);
+  }
+}
+
+Float Executor::getWorstSliceMem(Int sliceWidth) {
+  return exp2l(sliceWidth) * sizeof(DdNode) / MEGA;
+}
 
-    if (verboseProfiling >= 2) {
-      util::printRow("joinNodeDiagramSize_" + to_string(joinNode->nodeIndex + 1), ddSize);
-    }
+Assignment Executor::getWidestAssignment(const JoinNonterminal* joinRoot, const vector<Int>& costSliceVars) {
+  Assignment assignment;
+  for (Int var : costSliceVars) { // 2 width predictions per var instead of 1 per slice
+    Assignment assignment0 = assignment;
+    assignment0.assign(var, false);
+    Assignment assignment1 = assignment;
+    assignment1.assign(var, true);
+    Set<Int> postProjectionVars0;
+    Set<Int> postProjectionVars1;
+    assignment = joinRoot->getSliceWidth(assignment1, postProjectionVars1) > joinRoot->getSliceWidth(assignment0, postProjectionVars0) ? assignment1 : assignment0;
+  }
+  return assignment;
+}
 
-    for (Int var : joinNode->preProjectionVars) {
-      if (varDdSizes.contains(var)) {
-        varDdSizes[var] = max(varDdSizes[var], ddSize);
-      }
-      else {
-        varDdSizes[var] = ddSize;
+size_t Executor::getProbeDdSize(const JoinNonterminal* joinRoot, const vector<Int>& costSliceVars, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap) {
+  Assignment assignment = getWidestAssignment(joinRoot, costSliceVars);
+  assignment.densify();
+  Float probeMem = maxMem / min(threadCount, static_cast<Int>(exp2l(costSliceVars.size())));
+  const Cudd* mgr = ddPackage == CUDD ? Dd::newMgr(probeMem, 0) : nullptr;
+
+  maxDdSize = 0;
+  probingSlice = true;
+  solveRootSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, nullptr);
+  probingSlice = false;
+
+  maximizerStack.clear(); // G_x of probe slice
+  releaseClauseDds();
+  delete mgr;
+  return maxDdSize;
+}
+
+vector<Int> Executor::getCostSliceVars(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap) {
+  Int apparentOuterVarCount = 0;
+  for (Int var : JoinNode::cnf.outerVars) {
+    apparentOuterVarCount += JoinNode::cnf.apparentVars.contains(var);
+  }
+
+  vector<Int> costSliceVars;
+  Set<Int> costSliceVarSet;
+  vector<Int> sliceWidths; // of each prefix of costSliceVars
+  Int timeSliceVarCount = MIN_INT; // shortest prefix after which more slices would not help
+  Int outerSliceVarCount = 0;
+  bool worstMemFits = false;
+  while (true) {
+    Map<Int, Float> varCostGains;
+    Float sliceCost = 0;
+    Int sliceWidth = 0;
+    updateSliceCost(joinRoot, costSliceVarSet, varCostGains, sliceCost, sliceWidth);
+    sliceWidths.push_back(sliceWidth);
+
+    Int sliceCount = exp2l(costSliceVars.size());
+    Int sliceThreadCount = min(threadCount, sliceCount);
+    worstMemFits = getWorstSliceMem(sliceWidth) <= maxMem / sliceThreadCount;
+    Float makespan = ceill(static_cast<Float>(sliceCount) / sliceThreadCount) * sliceCost;
+
+    Int bestVar = MIN_INT;
+    Float bestGain = -INF;
+    bool innerSliceable = outerSliceVarCount == apparentOuterVarCount; // inner vars are quantified below all outer vars
+    for (const auto& [var, gain] : varCostGains) { // ties broken by smaller var
+      if ((innerSliceable || JoinNode::cnf.outerVars.contains(var)) && (gain > bestGain || (gain == bestGain && var < bestVar))) {
+        bestVar = var;
+        bestGain = gain;
       }
     }
+    if (bestVar == MIN_INT || costSliceVars.size() >= MAX_SLICE_VAR_COUNT) {
+      break;
+    }
+
+    Int nextSliceCount = sliceCount * 2;
+    Float nextMakespan = ceill(static_cast<Float>(nextSliceCount) / min(threadCount, nextSliceCount)) * (sliceCost - bestGain);
+    if (timeSliceVarCount == MIN_INT && nextMakespan >= makespan) { // more slices would not help
+      timeSliceVarCount = costSliceVars.size();
+    }
+    if (timeSliceVarCount != MIN_INT && worstMemFits) { // even if every diagram had 2^width nodes
+      break;
+    }
+
+    costSliceVars.push_back(bestVar);
+    costSliceVarSet.insert(bestVar);
+    outerSliceVarCount += JoinNode::cnf.outerVars.contains(bestVar);
   }
-}
 
-void Executor::printVarDurations() {
-  multimap<Float, Int, greater<Float>> timedVars = util::flipMap(varDurations); // duration |-> var
-  for (pair<Float, Int> timedVar : timedVars) {
-    util::printRow("varTotalSeconds_" + to_string(timedVar.second), timedVar.first);
+  Float sliceMem = getWorstSliceMem(sliceWidths.back());
+  if (timeSliceVarCount != MIN_INT && timeSliceVarCount < costSliceVars.size() && worstMemFits) { // only worst-case mem asks for extra slices
+    Int probeVarCount = costSliceVars.size();
+    size_t probeDdSize = getProbeDdSize(joinRoot, costSliceVars, cnfVarToDdVarMap, ddVarToCnfVarMap);
+    Int firstProbeVarCount = probeVarCount;
+    size_t firstProbeDdSize = probeDdSize;
+    while (probeVarCount > timeSliceVarCount + PROBE_SLICE_VAR_MARGIN && 2 * probeDdSize * sizeof(DdNode) / MEGA <= maxMem / min(threadCount, static_cast<Int>(exp2l(probeVarCount - 1)))) { // unslicing a var at most doubles a diagram
+      probeVarCount--;
+      probeDdSize = getProbeDdSize(joinRoot, vector<Int>(costSliceVars.begin(), costSliceVars.begin() + probeVarCount), cnfVarToDdVarMap, ddVarToCnfVarMap); // widest slices are nested
+    }
+    Float growth = 2; // of biggest diagram per unsliced var
+    if (probeVarCount < firstProbeVarCount) {
+      growth = max(static_cast<Float>(1), min(growth, powl(static_cast<Float>(probeDdSize) / max(firstProbeDdSize, static_cast<size_t>(1)), static_cast<Float>(1) / (firstProbeVarCount - probeVarCount))));
+    }
+    util::printRow("probeSliceVarCount", probeVarCount);
+    util::printRow("probeDiagramSize", probeDdSize);
+    util::printRow("probeDiagramGrowth", growth);
+
+    Int sliceVarCount = timeSliceVarCount;
+    while (true) {
+      Float probeMem = probeDdSize * powl(growth, probeVarCount - sliceVarCount) * sizeof(DdNode) / MEGA;
+      sliceMem = min(probeMem, getWorstSliceMem(sliceWidths.at(sliceVarCount)));
+      if (sliceVarCount == costSliceVars.size() || sliceMem <= maxMem / min(threadCount, static_cast<Int>(exp2l(sliceVarCount)))) {
+        break;
+      }
+      sliceVarCount++;
+    }
+    costSliceVars.resize(sliceVarCount);
   }
-}
 
-void Executor::printVarDdSizes() {
-  multimap<size_t, Int, greater<size_t>> sizedVars = util::flipMap(varDdSizes); // dd size |-> var
-  for (pair<size_t, Int> sizedVar : sizedVars) {
-    util::printRow("varMaxDiagramSize_" + to_string(sizedVar.second), sizedVar.first);
+  util::printRow("costSliceVarCount", costSliceVars.size());
+  util::printRow("predictedSliceMegabytes", sliceMem);
+  if (verboseSolving >= 2) {
+    cout << "c cost slice vars: {";
+    for (Int var : costSliceVars) {
+      cout << " " << var;
+    }
+    cout << " }\n";
   }
+
+  return costSliceVars;
 }
 
-Dd Executor::getClauseDd(const Map<Int, Int>& cnfVarToDdVarMap, const Clause& clause, const Cudd* mgr, const Assignment& assignment) {
-  Dd clauseDd = Dd::getZeroDd(mgr);
-  for (Int literal : clause) {
-    bool val = literal > 0;
-    Int cnfVar = abs(literal);
-    auto it = assignment.find(cnfVar);
-    if (it != assignment.end()) { // slices clause on literal
-      if (it->second == val) { // returns satisfied clause
-        return Dd::getOneDd(mgr);
-      } // excludes unsatisfied literal from clause otherwise
-    }
-    else {
-      Int ddVar = cnfVarToDdVarMap.at(cnfVar);
-      Dd literalDd = Dd::getVarDd(ddVar, val, mgr);
-      clauseDd = clauseDd.getMax(literalDd);
+Int Executor::getSliceMask(const Assignment& assignment) {
+  Int mask = 0;
+  for (Int bit = 0; bit < sliceVars.size(); bit++) {
+    if (assignment.at(sliceVars.at(bit))) {
+      mask |= 1LL << bit;
     }
   }
-  return clauseDd;
+  return mask;
 }
 
-Dd Executor::solveSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment) {
+Int Executor::setMemoNodeMasks(const JoinNode* joinNode) {
+  Int mask = 0;
   if (joinNode->isTerminal()) {
-    TimePoint terminalStartPoint = util::getTimePoint();
-
-    Dd d = getClauseDd(cnfVarToDdVarMap, JoinNode::cnf.clauses.at(joinNode->nodeIndex), mgr, assignment);
-
-    updateVarDurations(joinNode, terminalStartPoint);
-    updateVarDdSizes(joinNode, d);
+    for (Int bit = 0; bit < sliceVars.size(); bit++) {
+      if (joinNode->preProjectionVars.contains(sliceVars.at(bit))) {
+        mask |= 1LL << bit;
+      }
+    }
+    return mask;
+  }
 
-    return d;
+  vector<pair<const JoinNode*, Int>> nonterminalChildMasks;
+  for (const JoinNode* child : joinNode->children) {
+    Int childMask = setMemoNodeMasks(child);
+    mask |= childMask;
+    if (!child->isTerminal()) {
+      nonterminalChildMasks.push_back({child, childMask});
+    }
   }
+  for (auto [child, childMask] : nonterminalChildMasks) {
+    if (childMask != mask) { // child is reused by slices that disagree only outside its subtree
+      memoNodeMasks[child->nodeIndex] = childMask;
+    }
+  }
+  return mask;
+}
 
-  vector<Dd> childDdList;
-  for (JoinNode* child : joinNode->children) {
-    childDdList.push_back(solveSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment));
+vector<Assignment> Executor::getSliceAssignments(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  vector<Assignment> assignments;
+  if (threadSliceCount == 0) {
+    for (Int var : getCostSliceVars(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap)) {
+      assignments = Assignment::extendAssignments(assignments, var);
+    }
+    if (assignments.empty()) {
+      assignments.push_back(Assignment());
+    }
+  }
+  else {
+    size_t sliceVarCount = ceill(log2l(threadCount * threadSliceCount)); // capped by length of slice var order
+    assignments = joinRoot->getOuterAssignments(sliceVarOrderHeuristic, sliceVarCount);
   }
 
-  TimePoint nonterminalStartPoint = util::getTimePoint();
-  Dd dd = Dd::getOneDd(mgr);
+  util::printRow("sliceCount", assignments.size());
 
-  if (joinPriority == ARBITRARY_PAIR) { // arbitrarily multiplies child ADDs
-    for (Dd childDd : childDdList) {
-      dd = dd.getProduct(childDd);
+  if (subtreeMemo) {
+    sliceVars.clear();
+    for (const auto& [var, val] : assignments.front()) {
+      sliceVars.push_back(var);
     }
-  }
-  else { // Dd::operator< handles both biggest-first and smallest-first
-    std::priority_queue<Dd> childDdQueue;
-    for (Dd childDd : childDdList) {
-      childDdQueue.push(childDd);
+    assert(sliceVars.size() < 63);
+
+    memoNodeMasks.clear();
+    setMemoNodeMasks(joinRoot);
+    util::printRow("memoNodeCount", memoNodeMasks.size());
+
+    Map<Int, Assignment> maskedAssignments; // sliceMask |-> assignment
+    for (const Assignment& assignment : assignments) {
+      maskedAssignments[getSliceMask(assignment)] = assignment;
     }
-    assert(!childDdQueue.empty());
-    while (childDdQueue.size() > 1) {
-      Dd dd1 = childDdQueue.top();
-      childDdQueue.pop();
-      Dd dd2 = childDdQueue.top();
-      childDdQueue.pop();
-      Dd dd3 = dd1.getProduct(dd2);
-      childDdQueue.push(dd3);
+    assignments.clear();
+    for (Int i = 0; i < maskedAssignments.size(); i++) { // consecutive slices differ in 1 var
+      assignments.push_back(maskedAssignments.at(i ^ (i >> 1)));
     }
-    dd = childDdQueue.top();
   }
+  else if (assignments.size() <= threadCount * MAX_WIDTH_SORTED_SLICES_PER_THREAD) { // width prediction walks join tree once per slice
+    multimap<Int, Assignment, greater<Int>> widthAssignments; // predicted width |-> assignment (most expensive slices are scheduled first)
+    for (const Assignment& assignment : assignments) {
+      Set<Int> postProjectionVars;
+      widthAssignments.insert({joinRoot->getSliceWidth(assignment, postProjectionVars), assignment});
+    }
 
-  for (Int cnfVar : joinNode->projectionVars) {
-    Int ddVar = cnfVarToDdVarMap.at(cnfVar);
+    util::printRow("sliceWidth", widthAssignments.begin()->first); // predicted width of biggest slice
 
-    bool additive = JoinNode::cnf.outerVars.contains(cnfVar);
-    if (existRandom) {
-      additive = !additive;
+    if (verboseSolving >= 2) {
+      for (const auto& [width, assignment] : widthAssignments) {
+        cout << "c predicted width " << right << setw(5) << width << ": { ";
+        assignment.printAssignment();
+        cout << " }\n";
+      }
     }
 
-    dd = dd.getAbstraction(ddVar, ddVarToCnfVarMap, JoinNode::cnf.literalWeights, assignment, additive, maximizerStack, mgr);
+    assignments.clear();
+    for (const auto& [width, assignment] : widthAssignments) {
+      assignments.push_back(assignment);
+    }
   }
 
-  updateVarDurations(joinNode, nonterminalStartPoint);
-  updateVarDdSizes(joinNode, dd);
-
-  return dd;
+  return assignments;
 }
 
-void Executor::solveThreadSlices(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Float threadMem, Int threadIndex, const vector<vector<Assignment>>& threadAssignmentLists, Number& totalSolution, mutex& solutionMutex) {
-  const vector<Assignment>& threadAssignments = threadAssignmentLists.at(threadIndex);
-  for (Int threadAssignmentIndex = 0; threadAssignmentIndex < threadAssignments.size(); threadAssignmentIndex++) {
-    TimePoint sliceStartPoint = util::getTimePoint();
+Number Executor::getSliceCombination(const vector<Number>& solutions, bool additive) {
+  if (solutions.size() == 1) {
+    return solutions.front();
+  }
 
-    Number partialSolution = solveSubtree(static_cast<const JoinNode*>(joinRoot), cnfVarToDdVarMap, ddVarToCnfVarMap, Dd::newMgr(threadMem, threadIndex), threadAssignments.at(threadAssignmentIndex)).extractConst();
+  if (!additive) {
+    Number maxSolution = solutions.front();
+    for (const Number& solution : solutions) {
+      maxSolution = max(maxSolution, solution); // log10 is monotonic
+    }
+    return maxSolution;
+  }
 
-    const std::lock_guard<mutex> g(solutionMutex);
+  if (logCounting) {
+    Number totalSolution(-INF);
+    for (const Number& solution : solutions) {
+      totalSolution = Number(totalSolution.getLogSumExp(solution));
+    }
+    return totalSolution;
+  }
 
-    if (verboseSolving >= 1) {
-      cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << threadAssignmentLists.size() << " | assignment " << setw(4) << threadAssignmentIndex + 1 << "/" << threadAssignments.size() << ": { ";
-      threadAssignments.at(threadAssignmentIndex).printAssignment();
-      cout << " }\n";
+  mpq_class exactSum; // dyadic fractions are summed without rounding
+  for (const Number& solution : solutions) {
+    exactSum += solution.getExactQuotient();
+  }
+  return multiplePrecision ? Number(exactSum) : Number(Number::getNearestFraction(exactSum));
+}
 
-      cout << "c thread " << right << setw(4) << threadIndex + 1 << "/" << threadAssignmentLists.size() << " | assignment " << setw(4) << threadAssignmentIndex + 1 << "/" << threadAssignments.size() << " | seconds " << left << setw(10) << util::getDuration(sliceStartPoint) << " | mc " << setw(15);
-      if (logCounting) {
-        cout << exp10l(partialSolution.fraction) << " | log10(mc) " << partialSolution.fraction << "\n";
-      }
-      else {
-        cout << partialSolution << "\n";
+Number Executor::getSliceFold(const vector<Assignment>& assignments, const vector<Number>& sliceSolutions) {
+  map<vector<Int>, Int> groupIndices; // outer literals |-> index of group of slices that agree on outer vars
+  vector<vector<Number>> groupSolutions; // groups in order of first slice
+  vector<Int> groupAssignmentIndices; // first slice of each group
+  for (Int assignmentIndex = 0; assignmentIndex < assignments.size(); assignmentIndex++) {
+    vector<Int> outerLiterals;
+    for (Int literal : getSliceLiterals(assignments.at(assignmentIndex))) {
+      if (JoinNode::cnf.outerVars.contains(abs(literal))) {
+        outerLiterals.push_back(literal);
       }
     }
+    auto [it, inserted] = groupIndices.insert({outerLiterals, groupSolutions.size()});
+    if (inserted) {
+      groupSolutions.push_back(vector<Number>());
+      groupAssignmentIndices.push_back(assignmentIndex);
+    }
+    groupSolutions.at(it->second).push_back(sliceSolutions.at(assignmentIndex));
+  }
 
-    totalSolution = logCounting ? Number(totalSolution.getLogSumExp(partialSolution)) : totalSolution + partialSolution;
+  vector<Number> outerSolutions;
+  for (const vector<Number>& innerSolutions : groupSolutions) {
+    outerSolutions.push_back(getSliceCombination(innerSolutions, existRandom)); // inner vars are additive iff existRandom
   }
-}
 
-vector<vector<Assignment>> Executor::getThreadAssignmentLists(const JoinNonterminal* joinRoot, Int sliceVarOrderHeuristic) {
-  size_t sliceVarCount = ceill(log2l(threadCount * threadSliceCount));
-  sliceVarCount = min(sliceVarCount, JoinNode::cnf.outerVars.size());
+  if (maximizingAssignment) { // ties broken by first group
+    Int bestGroupIndex = 0;
+    for (Int groupIndex = 1; groupIndex < outerSolutions.size(); groupIndex++) {
+      if (outerSolutions.at(bestGroupIndex) < outerSolutions.at(groupIndex)) {
+        bestGroupIndex = groupIndex;
+      }
+    }
+    Int bestAssignmentIndex = groupAssignmentIndices.at(bestGroupIndex);
+    maximizerSlice = Assignment();
+    for (const auto& [var, val] : assignments.at(bestAssignmentIndex)) {
+      if (JoinNode::cnf.outerVars.contains(var)) {
+        maximizerSlice.assign(var, val);
+      }
+    }
 
-  Int remainingSliceCount = exp2l(sliceVarCount);
-  Int remainingThreadCount = threadCount;
-  vector<Int> threadSliceCounts;
-  while (remainingThreadCount > 0) {
-    Int sliceCount = ceill(static_cast<Float>(remainingSliceCount) / remainingThreadCount);
-    threadSliceCounts.push_back(sliceCount);
-    remainingSliceCount -= sliceCount;
-    remainingThreadCount--;
+    maximizerStack.clear(); // stack is empty if inner vars are sliced (all outer vars are then sliced)
+    if (sliceMaximizerStacks.contains(bestAssignmentIndex)) { // best slice of group is best slice of its thread
+      maximizerStack.swap(sliceMaximizerStacks.at(bestAssignmentIndex));
+    }
+    sliceMaximizerStacks.clear();
   }
-  assert(remainingSliceCount == 0);
 
-  if (verboseSolving >= 1) {
-    cout << "c thread slice counts: { ";
-    for (Int sliceCount : threadSliceCounts) {
-      cout << sliceCount << " ";
+  return getSliceCombination(outerSolutions, !existRandom);
+}
+
+Number Executor::solveCnf(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
+  if (workStealing) {
+    if (ddPackage == SYLVAN) { // Lace workers steal sibling subtrees
+      LACE_ME;
+      return Dd(Mtbdd(CALL(laceSolveSubtree, joinRoot, &cnfVarToDdVarMap, &ddVarToCnfVarMap))).extractConst();
     }
-    cout << "}\n";
+    return solveWorkStealing(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap);
   }
 
-  vector<Assignment> assignments = joinRoot->getOuterAssignments(sliceVarOrderHeuristic, sliceVarCount);
-  vector<vector<Assignment>> threadAssignmentLists;
-  vector<Assignment> threadAssignmentList;
-  for (Int assignmentIndex = 0, threadListIndex = 0; assignmentIndex < assignments.size() && threadListIndex < threadSliceCounts.size(); assignmentIndex++) {
-    threadAssignmentList.push_back(assignments.at(assignmentIndex));
-    if (threadAssignmentList.size() == threadSliceCounts.at(threadListIndex)) {
-      threadAssignmentLists.push_back(threadAssignmentList);
-      threadAssignmentList.clear();
-      threadListIndex++;
-    }
+  if (workerProcesses) {
+    return solveWorkerProcesses(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
   }
 
-  if (verboseSolving >= 2) {
-    for (Int threadIndex = 0; threadIndex < threadAssignmentLists.size(); threadIndex++) {
-      const vector<Assignment>& threadAssignments = threadAssignmentLists.at(threadIndex);
-      cout << "c assignments in thread " << right << setw(4) << threadIndex + 1 << ":";
-      for (const Assignment& assignment : threadAssignments) {
-        cout << " { ";
-        assignment.printAssignment();
-        cout << " }";
-      }
-      cout << "\n";
-    }
+  if (clusterRole == COORDINATOR) {
+    return solveCoordinator(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+  }
+  if (clusterRole == WORKER) {
+    return solveClusterWorker(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
   }
 
-  return threadAssignmentLists;
-}
+  vector<Assignment> assignments = getSliceAssignments(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+  if (!journalFilePath.empty()) {
+    sliceJournal = new SliceJournal(journalFilePath, getRunHash(joinRoot, assignments), assignments);
+    util::printRow("journaledSliceCount", sliceJournal->sliceSolutions.size());
+  }
 
-Number Executor::solveCnf(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, Int sliceVarOrderHeuristic) {
-  if (ddPackage == SYLVAN) {
-    return solveSubtree(
-      static_cast<const JoinNode*>(joinRoot),
-      cnfVarToDdVarMap,
-      ddVarToCnfVarMap
-    ).extractConst();
+  Number totalSolution = getSliceFold(assignments, solveSliceThreads(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, assignments));
+
+  if (sliceJournal != nullptr) {
+    delete sliceJournal; // complete journal is kept: rerun only sums its entries
+    sliceJournal = nullptr;
   }
+  return totalSolution;
+}
 
-  vector<vector<Assignment>> threadAssignmentLists = getThreadAssignmentLists(joinRoot, sliceVarOrderHeuristic);
-  util::printRow("sliceWidth", joinRoot->getWidth(threadAssignmentLists.front().front())); // any assignment would work
-  Number totalSolution = logCounting ? Number(-INF) : Number();
+vector<Number> Executor::solveSliceThreads(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const vector<Assignment>& assignments) {
+  std::atomic<Int> nextAssignmentIndex = 0; // shared slice queue
+  vector<Number> sliceSolutions(assignments.size());
+  if (sliceJournal != nullptr) {
+    for (const auto& [assignmentIndex, partialSolution] : sliceJournal->sliceSolutions) {
+      sliceSolutions.at(assignmentIndex) = partialSolution;
+    }
+  }
   mutex solutionMutex;
 
-  Float threadMem = maxMem / threadAssignmentLists.size();
-  util::printRow("threadMaxMemMegabytes", threadMem);
+  Int sliceThreadCount = min(threadCount, static_cast<Int>(assignments.size()));
+  Float threadMem = maxMem / sliceThreadCount;
+  if (ddPackage == CUDD) {
+    util::printRow("threadMaxMemMegabytes", threadMem);
+  }
 
-  vector<thread> threads;
+  Int blockSize = 1; // consecutive slices pulled by a thread at once
+  if (subtreeMemo) { // aligned blocks of Gray-code order keep neighbouring slices on 1 thread (at least 1 block per thread)
+    while (2 * blockSize * sliceThreadCount <= assignments.size()) {
+      blockSize *= 2;
+    }
+    util::printRow("sliceBlockSize", blockSize);
+  }
 
-  Int threadIndex = 0;
-  for (; threadIndex < threadAssignmentLists.size() - 1; threadIndex++) {
-    threads.push_back(thread(
-      solveThreadSlices,
-      std::cref(joinRoot),
-      std::cref(cnfVarToDdVarMap),
-      std::cref(ddVarToCnfVarMap),
-      threadMem,
-      threadIndex,
-      threadAssignmentLists,
-      std::ref(totalSolution),
-      std::ref(solutionMutex)
-    ));
+  TimePoint slicesStartPoint = util::getTimePoint();
+  vector<Float> busyDurations(sliceThreadCount);
+  std::function<void(Int)> solveSlices = [&](Int threadIndex) {
+    if (threadIndex < sliceThreadCount) {
+      solveThreadSlices(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, threadMem, threadIndex, assignments, nextAssignmentIndex, blockSize, sliceSolutions, solutionMutex, busyDurations.at(threadIndex));
+    }
+  };
+  if (ddPackage == SYLVAN) { // each Lace worker runs 1 slice loop in a new frame, then helps with diagram operations of other loops
+    LACE_ME;
+    TOGETHER(laceSolveThreadSlices, &solveSlices); // no loop waits in a deque, so a worker syncing inside a slice cannot leapfrog into another loop
   }
-  solveThreadSlices(
-    joinRoot,
-    cnfVarToDdVarMap,
-    ddVarToCnfVarMap,
-    threadMem,
-    threadIndex,
-    threadAssignmentLists,
-    totalSolution,
-    solutionMutex
-  );
-  for (thread& t : threads) {
-    t.join();
+  else {
+    vector<thread> threads;
+    for (Int threadIndex = 0; threadIndex < sliceThreadCount - 1; threadIndex++) {
+      threads.push_back(thread(solveSlices, threadIndex));
+    }
+    solveSlices(sliceThreadCount - 1);
+    for (thread& t : threads) {
+      t.join();
+    }
   }
 
-  return totalSolution;
+  if (splitBudget > 0) {
+    util::printRow("splitCount", splitCount);
+  }
+
+  if (verboseSolving >= 1) {
+    Float slicesDuration = util::getDuration(slicesStartPoint);
+    for (Int threadIndex = 0; threadIndex < sliceThreadCount; threadIndex++) {
+      util::printRow("threadBusySeconds_" + to_string(threadIndex + 1), busyDurations.at(threadIndex));
+      util::printRow("threadIdleSeconds_" + to_string(threadIndex + 1), slicesDuration - busyDurations.at(threadIndex));
+    }
+  }
+
+  return sliceSolutions;
 }
 
 Number Executor::processHiddenVar(const Number &apparentSolution, Int cnfVar, bool additive) {
@@ -906,6 +2549,103 @@ void Executor::printSolutionRows(const Number& solution, bool surelyUnsat, size_
   cout << THIN_LINE;
 }
 
+bool Executor::setMaxProjectionNodes(const JoinNode* joinNode) {
+  bool maxProjection = false;
+  for (Int var : joinNode->projectionVars) {
+    maxProjection = maxProjection || JoinNode::cnf.outerVars.contains(var); // existRandom
+  }
+  for (const JoinNode* child : joinNode->children) {
+    maxProjection = setMaxProjectionNodes(child) || maxProjection; // every child is visited
+  }
+  if (maxProjection) {
+    maxProjectionNodes.insert(joinNode->nodeIndex);
+  }
+  return maxProjection;
+}
+
+Dd Executor::solveCheckpointSubtree(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, const Assignment& assignment, Map<Int, vector<Dd>>& checkpointDds) {
+  if (!maxProjectionNodes.contains(joinNode->nodeIndex)) { // includes terminals
+    return solveSubtree(joinNode, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment);
+  }
+
+  vector<Dd> childDdList;
+  for (const JoinNode* child : joinNode->children) {
+    childDdList.push_back(solveCheckpointSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, checkpointDds));
+  }
+  Dd dd = joinChildDds(joinNode, childDdList, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, nullptr); // fused like counting pass
+  checkpointDds[joinNode->nodeIndex] = childDdList;
+  return dd;
+}
+
+void Executor::recomputeSubtreeMaximizer(const JoinNode* joinNode, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap, const Cudd* mgr, Assignment& assignment, Map<Int, vector<Dd>>& checkpointDds) {
+  if (!maxProjectionNodes.contains(joinNode->nodeIndex)) {
+    return;
+  }
+
+  vector<Dd> childDdList; // checkpoint restricted to max vars fixed by ancestors, so diagrams stay within subtree
+  for (const Dd& childDd : checkpointDds.at(joinNode->nodeIndex)) {
+    Dd dd = childDd;
+    for (Int ddVar : childDd.getSupport()) {
+      Int cnfVar = ddVarToCnfVarMap.at(ddVar);
+      if (assignment.contains(cnfVar)) {
+        dd = dd.getComposition(ddVar, assignment.at(cnfVar), mgr);
+      }
+    }
+    childDdList.push_back(dd);
+  }
+  checkpointDds.erase(joinNode->nodeIndex);
+
+  for (Int var : joinNode->projectionVars) { // max vars commute, so each is fixed by comparing its 2 cofactors with the others maximized
+    if (!JoinNode::cnf.outerVars.contains(var) || assignment.contains(var)) { // existRandom
+      continue;
+    }
+    Int ddVar = cnfVarToDdVarMap.at(var);
+    vector<Dd> childDdList0;
+    vector<Dd> childDdList1;
+    for (const Dd& childDd : childDdList) {
+      childDdList0.push_back(childDd.getComposition(ddVar, false, mgr));
+      childDdList1.push_back(childDd.getComposition(ddVar, true, mgr));
+    }
+    assignment.assign(var, false);
+    Number solution0 = joinChildDds(joinNode, childDdList0, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, nullptr).extractConst(); // fused, and constant as vars of ancestors are assigned
+    assignment.assign(var, true);
+    Number solution1 = joinChildDds(joinNode, childDdList1, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, nullptr).extractConst();
+    bool val = solution0 <= solution1; // ties go to true like G_x
+    assignment.assign(var, val);
+    childDdList = val ? childDdList1 : childDdList0;
+  }
+  childDdList.clear();
+
+  for (const JoinNode* child : joinNode->children) { // subtrees are independent given assignment
+    recomputeSubtreeMaximizer(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, assignment, checkpointDds);
+  }
+}
+
+void Executor::recomputeMaximizer(const JoinNonterminal* joinRoot, const Map<Int, Int>& cnfVarToDdVarMap, const vector<Int>& ddVarToCnfVarMap) {
+  TimePoint maximizerStartPoint = util::getTimePoint();
+  const Cudd* mgr = ddPackage == CUDD ? Dd::newMgr(maxMem, 0) : nullptr; // slice threads are done
+  maximizerSlice.densify();
+  maxProjectionNodes.clear();
+  setMaxProjectionNodes(joinRoot);
+
+  Map<Int, vector<Dd>> checkpointDds; // each subtree is solved once, then only joins of nodes with max projection are redone top-down
+  const JoinNode* root = static_cast<const JoinNode*>(joinRoot);
+  if (maxProjectionNodes.contains(root->nodeIndex)) {
+    vector<Dd> rootChildDdList; // root is not joined bottom-up
+    for (const JoinNode* child : root->children) {
+      rootChildDdList.push_back(solveCheckpointSubtree(child, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, maximizerSlice, checkpointDds));
+    }
+    checkpointDds[root->nodeIndex] = rootChildDdList;
+  }
+  recomputeSubtreeMaximizer(root, cnfVarToDdVarMap, ddVarToCnfVarMap, mgr, maximizerSlice, checkpointDds); // sliced outer vars stay fixed
+  assert(checkpointDds.empty());
+  releaseClauseDds();
+  delete mgr;
+  if (verboseSolving >= 1) {
+    util::printRow("maximizerSeconds", util::getDuration(maximizerStartPoint));
+  }
+}
+
 void Executor::printMaximizerRow(const vector<Int>& ddVarToCnfVarMap) {
   vector<int> ddVarAssignment(ddVarToCnfVarMap.size(), 0);
   vector<Int> poppedDdVars;
@@ -930,6 +2670,9 @@ void Executor::printMaximizerRow(const vector<Int>& ddVarToCnfVarMap) {
     }
     cout << ddVarToCnfVarMap.at(ddVar) << " ";
   }
+  for (Int literal : getSliceLiterals(maximizerSlice)) { // sliced and recomputed outer vars are not on stack
+    cout << literal << " ";
+  }
   cout << "0\n";
 }
 
@@ -949,6 +2692,14 @@ Executor::Executor(const JoinNonterminal* joinRoot, Int ddVarOrderHeuristic, Int
     cnfVarToDdVarMap[cnfVar] = ddVar;
   }
 
+  if (fusedAbstraction) {
+    Dd::setAbstractionWeights(ddVarToCnfVarMap, JoinNode::cnf.literalWeights);
+  }
+
+  if (benchmarkingJoins) {
+    benchmarkJoinPriorities(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
+  }
+
   Number n = solveCnf(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap, sliceVarOrderHeuristic);
 
   printVarDurations();
@@ -961,8 +2712,162 @@ Executor::Executor(const JoinNonterminal* joinRoot, Int ddVarOrderHeuristic, Int
   printSolutionRows(n);
 
   if (maximizingAssignment) {
+    if (recomputingMaximizer) {
+      recomputeMaximizer(joinRoot, cnfVarToDdVarMap, ddVarToCnfVarMap);
+    }
     printMaximizerRow(ddVarToCnfVarMap);
   }
+
+  Dd::clearAbstractionWeights();
+}
+
+/* Lace tasks =============================================================== */
+
+TASK_IMPL_3(MTBDD, laceSolveSubtree, const JoinNode*, joinNode, const CnfVarToDdVarMap*, cnfVarToDdVarMap, const vector<Int>*, ddVarToCnfVarMap) {
+  if (joinNode->isTerminal()) {
+    return Executor::solveSubtree(joinNode, *cnfVarToDdVarMap, *ddVarToCnfVarMap).mtbdd.GetMTBDD();
+  }
+
+  Int childCount = joinNode->children.size();
+  for (Int childIndex = childCount - 1; childIndex > 0; childIndex--) {
+    mtbdd_refs_spawn(SPAWN(laceSolveSubtree, joinNode->children.at(childIndex), cnfVarToDdVarMap, ddVarToCnfVarMap));
+  }
+  vector<Mtbdd> childMtbdds(childCount); // protected from garbage collection
+  childMtbdds.at(0) = CALL(laceSolveSubtree, joinNode->children.at(0), cnfVarToDdVarMap, ddVarToCnfVarMap);
+  for (Int childIndex = 1; childIndex < childCount; childIndex++) { // syncs in reverse order of spawning
+    childMtbdds.at(childIndex) = mtbdd_refs_sync(SYNC(laceSolveSubtree));
+  }
+
+  vector<Dd> childDdList;
+  for (const Mtbdd& childMtbdd : childMtbdds) {
+    childDdList.push_back(Dd(childMtbdd));
+  }
+  return Executor::joinChildDds(joinNode, childDdList, *cnfVarToDdVarMap, *ddVarToCnfVarMap, nullptr, Assignment(), Executor::getKeptMaximizerStack()).mtbdd.GetMTBDD();
+}
+
+TASK_IMPL_2(MTBDD, laceGetProduct, MTBDD, dd1, MTBDD, dd2) {
+  return Dd(Mtbdd(dd1)).getProduct(Dd(Mtbdd(dd2))).mtbdd.GetMTBDD();
+}
+
+TASK_IMPL_4(MTBDD, laceTimesAbstract, MTBDD, f, MTBDD, g, MTBDD, cube, bool, additive) { // mirrors cuddAddTimesAbstractRecur
+  MTBDD zero = Dd::zeroDd->mtbdd.GetMTBDD();
+  if (f == sylvan::mtbdd_false || g == sylvan::mtbdd_false || f == zero || g == zero) { // partial function is 0
+    return zero;
+  }
+  if (cube == mtbdd_true) {
+    return Dd(Mtbdd(f)).getProduct(Dd(Mtbdd(g))).mtbdd.GetMTBDD();
+  }
+
+  sylvan_gc_test();
+
+  uint32_t cubeVar = mtbdd_getvar(cube);
+  uint32_t fVar = mtbdd_isleaf(f) ? UINT32_MAX : mtbdd_getvar(f);
+  uint32_t gVar = mtbdd_isleaf(g) ? UINT32_MAX : mtbdd_getvar(g);
+  uint32_t topVar = std::min(fVar, gVar);
+
+  if (topVar > cubeVar) { // cubeVar does not appear in product, so its weights are combined
+    Mtbdd abstraction(CALL(laceTimesAbstract, f, g, mtbdd_gethigh(cube), additive));
+    const Dd& negativeWeight = Dd::negativeWeightDds.at(cubeVar);
+    const Dd& positiveWeight = Dd::positiveWeightDds.at(cubeVar);
+    Dd weight = additive ? negativeWeight.getSum(positiveWeight) : negativeWeight.getMax(positiveWeight);
+    return Dd(abstraction).getProduct(weight).mtbdd.GetMTBDD();
+  }
+
+  if (f > g) { // commutative, so swapped for cache hits
+    std::swap(f, g);
+    std::swap(fVar, gVar);
+  }
+  uint64_t opid = additive ? Dd::timesSumAbstractOpid : Dd::timesMaxAbstractOpid;
+  MTBDD result;
+  if (cache_get3(opid, f, g, cube, &result)) {
+    return result;
+  }
+
+  MTBDD fLow = fVar == topVar ? mtbdd_getlow(f) : f;
+  MTBDD fHigh = fVar == topVar ? mtbdd_gethigh(f) : f;
+  MTBDD gLow = gVar == topVar ? mtbdd_getlow(g) : g;
+  MTBDD gHigh = gVar == topVar ? mtbdd_gethigh(g) : g;
+  MTBDD nextCube = topVar == cubeVar ? mtbdd_gethigh(cube) : cube;
+
+  mtbdd_refs_spawn(SPAWN(laceTimesAbstract, fHigh, gHigh, nextCube, additive));
+  MTBDD low = mtbdd_refs_push(CALL(laceTimesAbstract, fLow, gLow, nextCube, additive));
+  MTBDD high = mtbdd_refs_push(mtbdd_refs_sync(SYNC(laceTimesAbstract)));
+
+  if (topVar == cubeVar) {
+    Dd term0 = Dd(Mtbdd(low)).getProduct(Dd::negativeWeightDds.at(topVar));
+    Dd term1 = Dd(Mtbdd(high)).getProduct(Dd::positiveWeightDds.at(topVar));
+    result = (additive ? term0.getSum(term1) : term0.getMax(term1)).mtbdd.GetMTBDD();
+  }
+  else {
+    result = mtbdd_makenode(topVar, low, high);
+  }
+  mtbdd_refs_pop(2);
+
+  cache_put3(opid, f, g, cube, result);
+  return result;
+}
+
+VOID_TASK_IMPL_1(laceSolveThreadSlices, const std::function<void(Int)>*, solveSlices) {
+  (*solveSlices)(LACE_WORKER_ID); // Executor::maximizerStack of this worker is used by this loop only
+}
+
+TASK_IMPL_2(MTBDD, logOpTimes, MTBDD*, pa, MTBDD*, pb) { // partial function is count 0, as in gmp_op_times
+  MTBDD a = *pa, b = *pb;
+  if (a == sylvan::mtbdd_false || b == sylvan::mtbdd_false) {
+    return sylvan::mtbdd_false;
+  }
+  if (mtbdd_isleaf(a) && mtbdd_isleaf(b)) {
+    return Dd::getLogLeaf(Dd::getLogLeafValue(a) + Dd::getLogLeafValue(b));
+  }
+  if (a < b) { // commutative, so swapped for cache hits
+    *pa = b;
+    *pb = a;
+  }
+  return sylvan::mtbdd_invalid;
+}
+
+TASK_IMPL_2(MTBDD, logOpPlus, MTBDD*, pa, MTBDD*, pb) {
+  MTBDD a = *pa, b = *pb;
+  if (a == sylvan::mtbdd_false) {
+    return b;
+  }
+  if (b == sylvan::mtbdd_false) {
+    return a;
+  }
+  if (mtbdd_isleaf(a) && mtbdd_isleaf(b)) {
+    return Dd::getLogLeaf(Number(Dd::getLogLeafValue(a)).getLogSumExp(Number(Dd::getLogLeafValue(b))));
+  }
+  if (a < b) {
+    *pa = b;
+    *pb = a;
+  }
+  return sylvan::mtbdd_invalid;
+}
+
+TASK_IMPL_2(MTBDD, logOpMax, MTBDD*, pa, MTBDD*, pb) {
+  MTBDD a = *pa, b = *pb;
+  if (a == sylvan::mtbdd_false || a == b) {
+    return b;
+  }
+  if (b == sylvan::mtbdd_false) {
+    return a;
+  }
+  if (mtbdd_isleaf(a) && mtbdd_isleaf(b)) {
+    return Dd::getLogLeafValue(a) > Dd::getLogLeafValue(b) ? a : b;
+  }
+  if (a < b) {
+    *pa = b;
+    *pb = a;
+  }
+  return sylvan::mtbdd_invalid;
+}
+
+TASK_IMPL_2(MTBDD, logOpGeq, MTBDD*, pa, MTBDD*, pb) { // not commutative
+  MTBDD a = *pa, b = *pb;
+  if (mtbdd_isleaf(a) && mtbdd_isleaf(b)) {
+    return Dd::getLogLeafValue(a) >= Dd::getLogLeafValue(b) ? mtbdd_true : sylvan::mtbdd_false;
+  }
+  return sylvan::mtbdd_invalid;
 }
 
 /* class OptionDict ========================================================= */
@@ -998,6 +2903,9 @@ void OptionDict::runCommand() const {
     util::printRow("projectedCounting", projectedCounting);
     util::printRow("existRandom", existRandom);
     util::printRow("maximizingAssignment", maximizingAssignment);
+    if (maximizingAssignment) {
+      util::printRow("recomputingMaximizer", recomputingMaximizer);
+    }
 
     util::printRow("plannerWaitSeconds", plannerWaitDuration);
 
@@ -1005,16 +2913,31 @@ void OptionDict::runCommand() const {
 
     util::printRow("threadCount", threadCount);
 
-    if (ddPackage == CUDD) {
+    util::printRow("workStealing", workStealing);
+    if (!workStealing) {
       util::printRow("threadSliceCount", threadSliceCount);
+      util::printRow("subtreeMemo", subtreeMemo);
+    }
+    if (ddPackage == CUDD && !workStealing) {
+      util::printRow("workerProcesses", workerProcesses);
+      util::printRow("clusterRole", CLUSTER_ROLES.at(clusterRole));
+      if (clusterRole != NO_CLUSTER) {
+        util::printRow("clusterAddress", clusterAddress);
+      }
+      if (!journalFilePath.empty()) {
+        util::printRow("journalFile", journalFilePath);
+      }
+      util::printRow("splitBudget", splitBudget);
     }
 
     util::printRow("randomSeed", randomSeed);
 
     util::printRow("diagramVarOrder", (ddVarOrderHeuristic < 0 ? "INVERSE_" : "") + CNF_VAR_ORDER_HEURISTICS.at(abs(ddVarOrderHeuristic)));
 
-    if (ddPackage == CUDD) {
+    if (!workStealing) {
       util::printRow("sliceVarOrder", (sliceVarOrderHeuristic < 0 ? "INVERSE_" : "") + util::getVarOrderHeuristics().at(abs(sliceVarOrderHeuristic)));
+    }
+    if (ddPackage == CUDD) {
       util::printRow("memSensitivityMegabytes", memSensitivity);
     }
 
@@ -1030,13 +2953,18 @@ void OptionDict::runCommand() const {
     }
 
     util::printRow("joinPriority", JOIN_PRIORITIES.at(joinPriority));
+    util::printRow("benchmarkingJoins", benchmarkingJoins);
+    util::printRow("fusedAbstraction", fusedAbstraction);
+    if (fusedAbstraction) {
+      util::printRow("earlyProjection", earlyProjection);
+    }
     cout << "\n";
   }
 
   try {
-    JoinNode::cnf = Cnf(cnfFilePath);
+    JoinNode::cnf = Cnf(cnfFilePath, threadCount);
 
-    if (JoinNode::cnf.clauses.empty()) {
+    if (JoinNode::cnf.getClauseCount() == 0) {
       cout << WARNING << "empty cnf\n";
       Executor::printSolutionRows(logCounting ? Number() : Number("1"));
       return;
@@ -1053,6 +2981,10 @@ void OptionDict::runCommand() const {
       if (multiplePrecision) {
         sylvan::gmp_init();
       }
+      if (logCounting) {
+        Dd::initLogLeafType();
+      }
+      Dd::initTimesAbstraction();
     }
 
     Executor executor(joinTreeProcessor.getJoinTreeRoot(), ddVarOrderHeuristic, sliceVarOrderHeuristic);
@@ -1075,11 +3007,18 @@ OptionDict::OptionDict(int argc, char** argv) {
     (WEIGHTED_COUNTING_OPTION, "weighted counting: 0, 1; int", value<Int>()->default_value("0"))
     (PROJECTED_COUNTING_OPTION, "projected counting: 0, 1; int", value<Int>()->default_value("0"))
     (EXIST_RANDOM_OPTION, "exist-random stochastic satisfiability: 0, 1; int", value<Int>()->default_value("0"))
-    (MAXIMIZING_ASSIGNMENT_OPTION, "maximizing assignment [with " + EXIST_RANDOM_OPTION + "_arg = 1]: 0, 1; int", value<Int>()->default_value("0"))
+    (MAXIMIZING_ASSIGNMENT_OPTION, "maximizing assignment [with " + EXIST_RANDOM_OPTION + "_arg = 1]: 0, 1, 2 (low-mem recomputation); int", value<Int>()->default_value("0"))
     (PLANNER_WAIT_OPTION, "planner wait duration (in seconds); float", value<Float>()->default_value(to_string(MIN_PLANNER_WAIT_DURATION)))
     (DD_PACKAGE_OPTION, helpDdPackage(), value<string>()->default_value(CUDD))
     (THREAD_COUNT_OPTION, "thread count, or 0 for hardware_concurrency value; int", value<Int>()->default_value("1"))
-    (THREAD_SLICE_COUNT_OPTION, "thread slice count" + util::useDdPackage(CUDD) + "; int", value<Int>()->default_value("1"))
+    (THREAD_SLICE_COUNT_OPTION, "thread slice count, or 0 for cost-model choice of slice vars; int", value<Int>()->default_value("1"))
+    (WORK_STEALING_OPTION, "work stealing of join-tree subtrees instead of slicing: 0, 1; int", value<Int>()->default_value("0"))
+    (SUBTREE_MEMO_OPTION, "subtree memoization across slices: 0, 1; int", value<Int>()->default_value("0"))
+    (WORKER_PROCESS_OPTION, "worker processes instead of threads for slices" + util::useDdPackage(CUDD) + ": 0, 1; int", value<Int>()->default_value("0"))
+    (CLUSTER_ROLE_OPTION, "cluster role for distributing slices" + util::useDdPackage(CUDD) + ": 0/NO_CLUSTER, 1/COORDINATOR, 2/WORKER; int", value<Int>()->default_value(to_string(NO_CLUSTER)))
+    (CLUSTER_ADDRESS_OPTION, "cluster address: Unix socket path or {host}:{port} for TCP; string", value<string>()->default_value(""))
+    (JOURNAL_FILE_OPTION, "journal file for resuming interrupted slicing" + util::useDdPackage(CUDD) + "; string", value<string>()->default_value(""))
+    (SPLIT_BUDGET_OPTION, "split budget (in diagram nodes) for splitting subtrees on outer vars on demand, or 0 for no splitting" + util::useDdPackage(CUDD) + "; int", value<Int>()->default_value("0"))
     (RANDOM_SEED_OPTION, "random seed; int", value<Int>()->default_value("0"))
     (DD_VAR_OPTION, util::helpVarOrderHeuristic("diagram"), value<Int>()->default_value(to_string(MCS)))
     (SLICE_VAR_OPTION, util::helpVarOrderHeuristic("slice"), value<Int>()->default_value(to_string(BIGGEST_NODE)))
@@ -1088,8 +3027,11 @@ OptionDict::OptionDict(int argc, char** argv) {
     (TABLE_RATIO_OPTION, "table ratio" + util::useDdPackage(SYLVAN) + ": log2(unique_size/cache_size); int", value<Int>()->default_value("1"))
     (INIT_RATIO_OPTION, "init ratio for tables" + util::useDdPackage(SYLVAN) + ": log2(max_size/init_size); int", value<Int>()->default_value("10"))
     (MULTIPLE_PRECISION_OPTION, "multiple precision" + util::useDdPackage(SYLVAN) + ": 0, 1; int", value<Int>()->default_value("0"))
-    (LOG_COUNTING_OPTION, "log counting" + util::useDdPackage(CUDD) + ": 0, 1; int", value<Int>()->default_value("0"))
+    (LOG_COUNTING_OPTION, "log counting: 0, 1; int", value<Int>()->default_value("0"))
     (JOIN_PRIORITY_OPTION, helpJoinPriority(), value<string>()->default_value(SMALLEST_PAIR))
+    (BENCHMARK_JOIN_OPTION, "benchmark of all join priorities before solving: 0, 1; int", value<Int>()->default_value("0"))
+    (FUSED_ABSTRACTION_OPTION, "fused projection of var blocks at join nodes: 0, 1; int", value<Int>()->default_value("1"))
+    (EARLY_PROJECTION_OPTION, "early projection inside join nodes [with " + FUSED_ABSTRACTION_OPTION + "_arg = 1]: 0, 1; int", value<Int>()->default_value("1"))
     (VERBOSE_CNF_OPTION, "verbose cnf processing: 0, " + INPUT_VERBOSITIES, value<Int>()->default_value("0"))
     (VERBOSE_JOIN_TREE_OPTION, "verbose join-tree processing: 0, " + INPUT_VERBOSITIES, value<Int>()->default_value("0"))
     (VERBOSE_PROFILING_OPTION, "verbose profiling: 0, 1, 2; int", value<Int>()->default_value("0"))
@@ -1103,7 +3045,10 @@ OptionDict::OptionDict(int argc, char** argv) {
     projectedCounting = result[PROJECTED_COUNTING_OPTION].as<Int>(); // global var
 
     existRandom = result[EXIST_RANDOM_OPTION].as<Int>(); // global var
-    maximizingAssignment = result[MAXIMIZING_ASSIGNMENT_OPTION].as<Int>(); // global var
+    Int maximizerMode = result[MAXIMIZING_ASSIGNMENT_OPTION].as<Int>();
+    assert(0 <= maximizerMode && maximizerMode <= 2);
+    maximizingAssignment = maximizerMode > 0; // global var
+    recomputingMaximizer = maximizerMode == 2; // global var
     assert(!maximizingAssignment || existRandom);
 
     plannerWaitDuration = result[PLANNER_WAIT_OPTION].as<Float>();
@@ -1121,7 +3066,28 @@ OptionDict::OptionDict(int argc, char** argv) {
     assert(threadCount > 0);
 
     threadSliceCount = result[THREAD_SLICE_COUNT_OPTION].as<Int>(); // global var
-    assert(threadSliceCount > 0);
+    assert(threadSliceCount >= 0);
+
+    workStealing = result[WORK_STEALING_OPTION].as<Int>(); // global var
+    assert(!maximizingAssignment || recomputingMaximizer || ddPackage == CUDD || !workStealing || threadCount == 1); // Lace workers would scatter Executor::maximizerStack
+
+    subtreeMemo = result[SUBTREE_MEMO_OPTION].as<Int>(); // global var
+    assert(!subtreeMemo || !maximizingAssignment); // memoized subtrees would skip Executor::maximizerStack
+
+    workerProcesses = result[WORKER_PROCESS_OPTION].as<Int>(); // global var
+    assert(!workerProcesses || (ddPackage == CUDD && !workStealing && !subtreeMemo && !maximizingAssignment)); // memo and maximizer stack live in 1 process
+
+    clusterRole = result[CLUSTER_ROLE_OPTION].as<Int>(); // global var
+    clusterAddress = result[CLUSTER_ADDRESS_OPTION].as<string>(); // global var
+    assert(CLUSTER_ROLES.contains(clusterRole));
+    assert(clusterRole == NO_CLUSTER || (ddPackage == CUDD && !workStealing && !workerProcesses && !maximizingAssignment && !clusterAddress.empty()));
+
+    journalFilePath = result[JOURNAL_FILE_OPTION].as<string>(); // global var
+    assert(journalFilePath.empty() || (ddPackage == CUDD && !workStealing && !workerProcesses && clusterRole == NO_CLUSTER && !maximizingAssignment)); // slice indices of 1 process
+
+    splitBudget = result[SPLIT_BUDGET_OPTION].as<Int>(); // global var
+    assert(splitBudget >= 0);
+    assert(splitBudget == 0 || (ddPackage == CUDD && !workStealing && !maximizingAssignment));
 
     randomSeed = result[RANDOM_SEED_OPTION].as<Int>(); // global var
 
@@ -1141,10 +3107,15 @@ OptionDict::OptionDict(int argc, char** argv) {
     assert(!multiplePrecision || ddPackage == SYLVAN);
 
     logCounting = result[LOG_COUNTING_OPTION].as<Int>(); // global var
-    assert(!logCounting || ddPackage == CUDD);
+    assert(!logCounting || !multiplePrecision); // log10 leaves are doubles
 
     joinPriority = result[JOIN_PRIORITY_OPTION].as<string>(); //global var
     assert(JOIN_PRIORITIES.contains(joinPriority));
+    benchmarkingJoins = result[BENCHMARK_JOIN_OPTION].as<Int>(); // global var
+    assert(!benchmarkingJoins || (!maximizingAssignment && journalFilePath.empty() && clusterRole == NO_CLUSTER)); // each solve would extend maximizer, journal and cluster state
+
+    fusedAbstraction = result[FUSED_ABSTRACTION_OPTION].as<Int>(); // global var
+    earlyProjection = result[EARLY_PROJECTION_OPTION].as<Int>(); // global var
 
     verboseCnf = result[VERBOSE_CNF_OPTION].as<Int>(); // global var
     verboseJoinTree = result[VERBOSE_JOIN_TREE_OPTION].as<Int>(); // global var
@@ -2,9 +2,16 @@
 
 /* inclusions =============================================================== */
 
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
 #include "../libraries/cudd/cplusplus/cuddObj.hh"
 #include "../libraries/cudd/cudd/cuddInt.h"
 
+#include "../libraries/sylvan/src/sylvan_cache.h"
 #include "../libraries/sylvan/src/sylvan_gmp.h"
 #include "../libraries/sylvan/src/sylvan_obj.hpp"
 
@@ -18,12 +25,23 @@ using sylvan::gmp_op_max_CALL;
 using sylvan::gmp_op_plus_CALL;
 using sylvan::gmp_op_minus_CALL;
 using sylvan::gmp_op_times_CALL;
+using sylvan::gmp_op_threshold_CALL;
 using sylvan::mtbdd_apply_CALL;
 using sylvan::mtbdd_fprintdot_nc;
 using sylvan::mtbdd_getdouble;
+using sylvan::mtbdd_gethigh;
+using sylvan::mtbdd_getlow;
 using sylvan::mtbdd_getvalue;
+using sylvan::mtbdd_getvar;
 using sylvan::mtbdd_gmp;
+using sylvan::mtbdd_isleaf;
 using sylvan::mtbdd_makenode;
+using sylvan::mtbdd_refs_pop;
+using sylvan::mtbdd_refs_push;
+using sylvan::mtbdd_refs_spawn;
+using sylvan::mtbdd_refs_sync;
+using sylvan::mtbdd_true;
+using sylvan::MTBDD;
 using sylvan::Mtbdd;
 
 using cxxopts::value;
@@ -32,6 +50,9 @@ using cxxopts::value;
 
 const Float MIN_PLANNER_WAIT_DURATION = 0.2;
 const Float MEGA = 1e6; // same as countAntom (1 MB = 1e6 B)
+const Int MAX_SLICE_VAR_COUNT = 62; // slice count and slice masks fit in Int
+const Int MAX_WIDTH_SORTED_SLICES_PER_THREAD = 16; // more slices are balanced by shared queue without predicting widths
+const Int PROBE_SLICE_VAR_MARGIN = 4; // probe slices for cost-model slicing have at least this many more slice vars than time alone needs
 
 const string WEIGHTED_COUNTING_OPTION = "wc";
 const string EXIST_RANDOM_OPTION = "er";
@@ -39,6 +60,13 @@ const string MAXIMIZING_ASSIGNMENT_OPTION = "ma";
 const string PLANNER_WAIT_OPTION = "pw";
 const string THREAD_COUNT_OPTION = "tc";
 const string THREAD_SLICE_COUNT_OPTION = "ts";
+const string WORK_STEALING_OPTION = "ws";
+const string SUBTREE_MEMO_OPTION = "sm";
+const string SPLIT_BUDGET_OPTION = "sb";
+const string WORKER_PROCESS_OPTION = "wp";
+const string CLUSTER_ROLE_OPTION = "cr";
+const string CLUSTER_ADDRESS_OPTION = "ca";
+const string JOURNAL_FILE_OPTION = "jf";
 const string DD_VAR_OPTION = "dv";
 const string SLICE_VAR_OPTION = "sv";
 const string MEM_SENSITIVITY_OPTION = "ms";
@@ -48,16 +76,32 @@ const string INIT_RATIO_OPTION = "ir";
 const string MULTIPLE_PRECISION_OPTION = "mp";
 const string LOG_COUNTING_OPTION = "lc";
 const string JOIN_PRIORITY_OPTION = "jp";
+const string FUSED_ABSTRACTION_OPTION = "fa";
+const string EARLY_PROJECTION_OPTION = "ep";
+const string BENCHMARK_JOIN_OPTION = "bj";
 const string VERBOSE_JOIN_TREE_OPTION = "vj";
 const string VERBOSE_PROFILING_OPTION = "vp";
 
+const Int NO_CLUSTER = 0;
+const Int COORDINATOR = 1;
+const Int WORKER = 2;
+const map<Int, string> CLUSTER_ROLES = {
+  {NO_CLUSTER, "NO_CLUSTER"},
+  {COORDINATOR, "COORDINATOR"},
+  {WORKER, "WORKER"}
+};
+
+const Float CONNECT_RETRY_DURATION = 10; // in seconds: workers may start before coordinator
+
 const string ARBITRARY_PAIR = "a";
 const string BIGGEST_PAIR = "b";
 const string SMALLEST_PAIR = "s";
+const string OVERLAP_PAIR = "o"; // smallest support of product, then smallest sum of sizes
 const map<string, string> JOIN_PRIORITIES = {
   {ARBITRARY_PAIR, "ARBITRARY_PAIR"},
   {BIGGEST_PAIR, "BIGGEST_PAIR"},
-  {SMALLEST_PAIR, "SMALLEST_PAIR"}
+  {SMALLEST_PAIR, "SMALLEST_PAIR"},
+  {OVERLAP_PAIR, "OVERLAP_PAIR"}
 };
 
 /* global vars ============================================================== */
@@ -66,12 +110,23 @@ extern Int dotFileIndex;
 
 extern bool existRandom;
 extern bool maximizingAssignment;
+extern bool recomputingMaximizer; // maximizer is recovered by top-down re-evaluation instead of from stored G_x diagrams
 extern string ddPackage;
 extern Int threadCount;
-extern Int threadSliceCount; // may be lower or higher than actual number of slices per thread
+extern Int threadSliceCount; // may be lower or higher than actual number of slices per thread (0: chosen by cost model)
+extern bool workStealing; // threads steal join-tree subtrees (CUDD managers or Lace tasks) instead of solving slices
+extern bool subtreeMemo; // slices reuse diagrams of subtrees that agree on their slice vars
+extern Int splitBudget; // max diagram size (in nodes) before subtree is split on outer var (0: no splitting)
+extern bool workerProcesses; // forked processes solve slices instead of threads
+extern Int clusterRole; // coordinator hands out slice ranges to workers over socket
+extern string clusterAddress; // Unix socket path or "{host}:{port}" for TCP
+extern string journalFilePath; // solved slices are appended and skipped on restart
 extern Float memSensitivity; // in MB (1e6 B)
 extern Float maxMem; // in MB (1e6 B)
 extern string joinPriority;
+extern bool benchmarkingJoins; // solves once per join priority before solving with joinPriority
+extern bool earlyProjection; // vars of multi-child join node are projected once all factors mentioning them are multiplied
+extern bool fusedAbstraction; // projection vars of join node are abstracted in blocks, first block with last product
 extern Int verboseJoinTree; // 1: parsed join tree, 2: raw join tree too
 extern Int verboseProfiling; // 1: sorted stats for cnf vars, 2: unsorted stats for join nodes too
 
@@ -134,15 +189,38 @@ public:
   ADD cuadd; // CUDD
   Mtbdd mtbdd; // Sylvan
 
+  mutable size_t nodeCount = 0; // cached by countNodes (0: not counted yet)
+  mutable std::shared_ptr<vector<uint64_t>> supportWords; // cached by getSupportWords
+
+  static uint32_t logLeafType; // Sylvan custom leaf holding log10 value as double bits (logCounting)
+
+  static vector<CUDD_VALUE_TYPE> negativeWeights; // ddVar |-> weight (log10 if logCounting) for Cudd_addTimesAbstract
+  static vector<CUDD_VALUE_TYPE> positiveWeights;
+  static vector<Dd> negativeWeightDds; // ddVar |-> constant diagram (Sylvan)
+  static vector<Dd> positiveWeightDds;
+  static Dd* zeroDd; // Sylvan (allocated after initialization)
+  static uint64_t timesSumAbstractOpid; // Sylvan cache
+  static uint64_t timesMaxAbstractOpid;
+
   Dd(const ADD& cuadd); // CUDD
   Dd(const Mtbdd& mtbdd); // SYLVAN
   Dd(const Dd& dd);
 
   static const Cudd* newMgr(Float mem, Int threadIndex); // CUDD
+  static char* logLeafToStr(int complement, uint64_t value, char* buf, size_t bufLength); // Sylvan callback for dot files
+  static void initLogLeafType(); // Sylvan
+  static MTBDD getLogLeaf(Float log10Value); // Sylvan
+  static Float getLogLeafValue(MTBDD leaf); // Sylvan
+  static void initTimesAbstraction(); // Sylvan
+  static void setAbstractionWeights(const vector<Int>& ddVarToCnfVarMap, const Map<Int, Number>& literalWeights);
+  static void clearAbstractionWeights(); // before Sylvan quits
   static Dd getConstDd(const Number& n, const Cudd* mgr);
   static Dd getZeroDd(const Cudd* mgr);
   static Dd getOneDd(const Cudd* mgr);
   static Dd getVarDd(Int ddVar, bool val, const Cudd* mgr);
+  static Dd getCubeDd(const vector<Int>& ddVars, const Cudd* mgr); // conjunction of positive literals
+  static Dd getClauseDd(vector<pair<Int, bool>> ddLiterals, const Cudd* mgr); // pair<ddVar, val>, built bottom-up
+  static Dd getTransfer(const ADD& cuadd, const Cudd* mgr); // copies cuadd into mgr without referencing nodes of its own manager
   size_t countNodes() const;
   bool operator<(const Dd& rightDd) const; // *this < rightDd (top of priotity queue is rightmost element)
   Number extractConst() const;
@@ -151,6 +229,8 @@ public:
   Dd getSum(const Dd& dd) const;
   Dd getMax(const Dd& dd) const; // real max (not 0-1 max)
   Set<Int> getSupport() const;
+  const vector<uint64_t>& getSupportWords() const; // bit ddVar % 64 of word ddVar / 64
+  static Int countUnitedVars(const Dd& dd1, const Dd& dd2); // support size of product
   Dd getBoolDiff(const Dd& rightDd) const; // returns 0-1 ADD for *this >= rightDd
   bool evalAssignment(vector<int>& ddVarAssignment) const;
   Dd getAbstraction(
@@ -159,16 +239,132 @@ public:
     const Map<Int, Number>& literalWeights,
     const Assignment& assignment,
     bool additive, // ? getSum : getMax
-    vector<pair<Int, Dd>>& maximizerStack,
+    vector<pair<Int, Dd>>* maximizerStack, // nullptr: G_x is not kept
+    const Cudd* mgr
+  ) const;
+  Dd getWeightedAbstraction( // getAbstraction of each ddVar in 1 pass
+    const vector<Int>& ddVars, // unassigned
+    bool additive,
+    const Cudd* mgr
+  ) const;
+  Dd getTimesAbstraction( // getProduct(dd) then getAbstraction of each ddVar, without building whole product
+    const Dd& dd,
+    const vector<Int>& ddVars, // unassigned
+    bool additive,
     const Cudd* mgr
   ) const;
   void writeDotFile(const Cudd* mgr, string dotFileDir = "./") const;
   static void writeInfoFile(const Cudd* mgr, string filePath);
 };
 
+/* classes for slicing ====================================================== */
+
+class SplitException : public std::exception { // diagram exceeded splitBudget or CUDD exceeded max mem
+public:
+  const JoinNode* joinNode; // whose diagram exceeded budget
+  bool memExceeded; // rather than splitBudget
+
+  const char* what() const noexcept override;
+
+  SplitException(const JoinNode* joinNode, bool memExceeded);
+};
+
+class SubtreeMemo { // diagrams of subtrees cached across slices of 1 block of 1 thread (CUDD)
+public:
+  Int sliceMask = 0; // current slice assignment as bitmask over Executor::sliceVars
+  Map<Int, Map<Int, Dd>> subtreeDds; // nodeIndex |-> (sliceMask restricted to subtree) |-> dd
+  Int hitCount = 0;
+};
+
+class WorkerProcess { // forked process solving a batch of slices (CUDD)
+public:
+  pid_t pid;
+  int readFd; // pipe from worker: "{index} {Number::getExactString()}" per solved slice
+  vector<Assignment> assignments; // batch
+  Int solvedCount = 0; // results arrive in order of assignments
+  string buffer; // incomplete line
+};
+
+class SliceJournal { // "h {runHash}" then "s {sliceIndex} {Number::getExactString()} {literals}" per solved slice
+public:
+  string filePath;
+  int fd; // append-only
+  Map<Int, Number> sliceSolutions; // sliceIndex |-> partial solution (from earlier runs)
+
+  void appendLine(const string& line); // synced to disk
+  void recordSlice(Int sliceIndex, const Assignment& assignment, const Number& partialSolution);
+
+  SliceJournal(const string& filePath, size_t runHash, const vector<Assignment>& assignments); // drops partial last line
+  ~SliceJournal();
+};
+
+class ClusterConnection { // worker connected to coordinator
+public:
+  int fd;
+  string buffer; // incomplete line
+  bool greeted = false; // "hello {sliceCount} {runHash}" checked
+  Int rangeBegin = MIN_INT; // slice range being solved (MIN_INT: idle)
+  Int rangeEnd = MIN_INT;
+};
+
+/* classes for work stealing ================================================ */
+
+class SubtreeTask { // nonterminal join node whose subtree is solved by 1 worker
+public:
+  const JoinNode* joinNode;
+  SubtreeTask* parentTask = nullptr;
+  vector<SubtreeTask*> childTasks; // aligned with joinNode->children (nullptr for JoinTerminal)
+  std::atomic<Int> pendingChildCount = 0; // task is ready when count is 0
+  Int workerIndex = MIN_INT; // whose manager owns cuadd
+  ADD* cuadd = nullptr; // result, allocated and freed by worker workerIndex
+  vector<pair<Int, Dd>> maximizerStack; // G_x diagrams of projections at joinNode
+};
+
+class SubtreeWorker { // owns 1 CUDD manager
+public:
+  const Cudd* mgr = nullptr;
+  std::deque<SubtreeTask*> readyTasks; // owner uses back, thieves use front
+  vector<ADD*> releasedAdds; // transferred child results to be freed by owner
+  mutex workerMutex; // guards readyTasks and releasedAdds
+};
+
+class TaskSignal { // wakes idle workers when a task is readied or root task is done
+public:
+  mutex signalMutex; // guards readiedTaskCount and rootDone
+  std::condition_variable readyCondition;
+  Int readiedTaskCount = 0;
+  bool rootDone = false;
+};
+
+using CnfVarToDdVarMap = Map<Int, Int>; // Lace macros split args on commas
+
+TASK_DECL_3(MTBDD, laceSolveSubtree, const JoinNode*, const CnfVarToDdVarMap*, const vector<Int>*); // spawns sibling subtrees
+TASK_DECL_2(MTBDD, laceGetProduct, MTBDD, MTBDD);
+TASK_DECL_4(MTBDD, laceTimesAbstract, MTBDD, MTBDD, MTBDD, bool); // Dd::getTimesAbstraction of cube
+VOID_TASK_DECL_1(laceSolveThreadSlices, const std::function<void(Int)>*); // run by every Lace worker (TOGETHER), sharing unique table
+TASK_DECL_2(MTBDD, logOpTimes, MTBDD*, MTBDD*); // adds log10 leaves
+TASK_DECL_2(MTBDD, logOpPlus, MTBDD*, MTBDD*); // log-sum-exp of log10 leaves
+TASK_DECL_2(MTBDD, logOpMax, MTBDD*, MTBDD*);
+TASK_DECL_2(MTBDD, logOpGeq, MTBDD*, MTBDD*); // Boolean leaves
+
+/* classes for executing join trees ========================================= */
+
 class Executor {
 public:
-  static vector<pair<Int, Dd>> maximizerStack; // pair<ddVar x, G_x>
+  static thread_local vector<pair<Int, Dd>> maximizerStack; // pair<ddVar x, G_x> of slice or subtree task being solved by this thread
+  static Map<Int, vector<pair<Int, Dd>>> sliceMaximizerStacks; // assignmentIndex |-> maximizer stack of best slice of each thread
+  static Assignment maximizerSlice; // sliced outer vars of best slice (and recomputed max vars)
+  static Set<Int> maxProjectionNodes; // nodeIndex of each nonterminal with max var projected in subtree (recomputingMaximizer)
+
+  static vector<Int> sliceVars; // slice var at index i is bit i of SubtreeMemo::sliceMask
+  static Map<Int, Int> memoNodeMasks; // nodeIndex |-> bitmask of slice vars in subtree (only for nodes worth memoizing)
+
+  static std::atomic<Int> splitCount;
+  static thread_local bool splitBudgetSuspended; // while tree with no outer var left to split is solved
+  static std::atomic<size_t> maxDdSize; // biggest intermediate diagram (benchmarkingJoins or probingSlice)
+  static bool probingSlice; // calibrates memory model of cost-model slicing
+
+  static SliceJournal* sliceJournal; // nullptr if journalFilePath is empty
 
   static Map<Int, Float> varDurations; // cnfVar |-> total execution time in seconds
   static Map<Int, size_t> varDdSizes; // cnfVar |-> max ADD size
@@ -179,33 +375,203 @@ public:
   static void printVarDurations();
   static void printVarDdSizes();
 
+  static thread_local Map<Int, Dd> clauseDds; // clauseIndex |-> unsliced clause diagram (CUDD)
+  static thread_local const Cudd* clauseDdMgr; // owner of clauseDds
+  static void releaseClauseDds(); // before mgr of this thread is deleted
   static Dd getClauseDd(
     const Map<Int, Int>& cnfVarToDdVarMap,
-    const Clause& clause,
+    Int clauseIndex,
     const Cudd* mgr,
     const Assignment& assignment
   );
+  static void checkSplitBudget(const Dd& dd, const JoinNode* joinNode); // throws SplitException
+  static Dd joinChildDds( // multiplies child diagrams then projects vars of joinNode
+    const JoinNode* joinNode,
+    const vector<Dd>& childDdList,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment,
+    vector<pair<Int, Dd>>* maximizerStack // nullptr: G_x diagrams are not kept
+  );
+  static void projectEarly( // multiplies buckets of child diagrams, each abstracting vars absent from other factors
+    const JoinNode* joinNode,
+    vector<Dd>& factorDds, // child diagrams, then remaining factors
+    vector<Int>& ddVars, // unassigned projection vars with same quantifier, then remaining ones
+    bool additive,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment
+  );
+  static vector<pair<Int, Dd>>* getKeptMaximizerStack(); // Executor::maximizerStack of this thread or nullptr
+  static Dd getLaceProduct(vector<Dd> dds); // parallel reduction tree (Sylvan)
+  static void multiplyDds( // multiplies pairs preferred by joinPriority until finalCount diagrams remain, most preferred first
+    vector<Dd>& dds,
+    Int finalCount,
+    const JoinNode* joinNode
+  );
+  static void benchmarkJoinPriorities(
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Int sliceVarOrderHeuristic
+  );
+  static Int getSplitVar( // unassigned outer var of failedNode projected in highest node of subtree, or MIN_INT
+    const JoinNode* joinNode,
+    const JoinNode* failedNode,
+    const Assignment& assignment
+  );
+  static Dd solveRootSubtree( // solves unsplittable tree with splitBudget suspended
+    const JoinNode* root,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment,
+    SubtreeMemo* subtreeMemo
+  );
+  static Dd solveSplitSubtree( // splits on outer var if diagram exceeds budget, else throws SplitException
+    const JoinNode* joinNode,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment,
+    SubtreeMemo* subtreeMemo
+  );
   static Dd solveSubtree(
     const JoinNode* joinNode,
     const Map<Int, Int>& cnfVarToDdVarMap,
     const vector<Int>& ddVarToCnfVarMap,
     const Cudd* mgr = nullptr,
-    const Assignment& assignment = Assignment()
+    const Assignment& assignment = Assignment(),
+    SubtreeMemo* subtreeMemo = nullptr
+  );
+  static vector<Number> solveSliceThreads( // partial solutions aligned with assignments
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const vector<Assignment>& assignments
   );
-  static void solveThreadSlices( // sequentially solves all slices in 1 thread
+  static void evictSubtreeMemo( // drops diagrams whose restricted slice mask does not recur in rest of block
+    SubtreeMemo* memo,
+    const vector<Assignment>& assignments,
+    Int nextAssignmentIndex,
+    Int blockEnd
+  );
+  static void solveThreadSlices( // pulls blocks of consecutive slices from shared queue until it is empty
     const JoinNonterminal* joinRoot,
     const Map<Int, Int>& cnfVarToDdVarMap,
     const vector<Int>& ddVarToCnfVarMap,
     Float threadMem,
     Int threadIndex,
-    const vector<vector<Assignment>>& threadAssignmentLists,
-    Number& totalSolution,
-    mutex& solutionMutex
+    const vector<Assignment>& assignments,
+    std::atomic<Int>& nextAssignmentIndex,
+    Int blockSize,
+    vector<Number>& sliceSolutions,
+    mutex& solutionMutex,
+    Float& busyDuration
   );
-  static vector<vector<Assignment>> getThreadAssignmentLists(
+  static void runWorkerProcess( // in forked process (does not return)
     const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Float processMem,
+    Int processIndex,
+    const vector<Assignment>& assignments,
+    int writeFd
+  );
+  static vector<Assignment> resliceAssignment(const Assignment& assignment, const vector<Int>& sliceVarOrder); // on 1 more outer var
+  static Number solveWorkerProcesses( // re-queues slices of crashed workers with further slicing
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
     Int sliceVarOrderHeuristic
   );
+  static bool readLines(int fd, string& buffer, vector<string>& lines); // false on EOF or error
+  static bool sendLine(int fd, const string& line); // socket
+  static bool hasUnixAddress(); // else TCP
+  static int openSocket(int family, const sockaddr* address, socklen_t addressLength, bool listening); // worker retries connecting
+  static int getClusterSocket(bool listening); // listens for coordinator, connects for worker
+  static vector<Int> getSliceLiterals(const Assignment& assignment); // sorted by var
+  static size_t getSliceHash(const vector<Assignment>& assignments); // FNV-1a
+  static size_t getRunHash(const JoinNonterminal* joinRoot, const vector<Assignment>& assignments); // cnf, join tree, options, and slices
+  static bool giveClusterRange( // false if connection is left idle
+    ClusterConnection& connection,
+    std::deque<pair<Int, Int>>& pendingRanges,
+    Int& nextSliceIndex,
+    Int sliceCount,
+    Int connectionCount
+  );
+  static Number solveCoordinator( // folds slice solutions returned by workers
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Int sliceVarOrderHeuristic
+  );
+  static Number solveClusterWorker( // returns total solution sent by coordinator
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Int sliceVarOrderHeuristic
+  );
+  static SubtreeTask* getSubtreeTask(const JoinNode* joinNode, std::deque<SubtreeTask>& tasks); // builds task graph
+  static SubtreeTask* popSubtreeTask(vector<SubtreeWorker>& workers, Int workerIndex); // steals if own deque is empty
+  static void releaseAdds(SubtreeWorker& worker);
+  static void solveSubtreeTask(
+    SubtreeTask* task,
+    vector<SubtreeWorker>& workers,
+    Int workerIndex,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    TaskSignal& taskSignal
+  );
+  static void runSubtreeWorker( // solves tasks until root task is done, sleeping while no task is ready
+    vector<SubtreeWorker>& workers,
+    Int workerIndex,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    TaskSignal& taskSignal
+  );
+  static Number solveWorkStealing(
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap
+  );
+  static void updateSliceCost( // for nonterminal nodes of subtree: diagram size is estimated as 2^width
+    const JoinNode* joinNode,
+    const Set<Int>& costSliceVars,
+    Map<Int, Float>& varCostGains, // var |-> decrease of slice cost if var were also sliced
+    Float& sliceCost, // estimated total diagram size
+    Int& sliceWidth
+  );
+  static Float getWorstSliceMem(Int sliceWidth); // megabytes of diagram with 2^width nodes
+  static Assignment getWidestAssignment( // greedily maximizes predicted width
+    const JoinNonterminal* joinRoot,
+    const vector<Int>& costSliceVars
+  );
+  static size_t getProbeDdSize( // nodes of biggest diagram of widest slice
+    const JoinNonterminal* joinRoot,
+    const vector<Int>& costSliceVars,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap
+  );
+  static vector<Int> getCostSliceVars( // greedily minimizes estimated makespan subject to max mem calibrated by probe slice
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap
+  );
+  static Int getSliceMask(const Assignment& assignment); // bitmask over sliceVars
+  static Int setMemoNodeMasks(const JoinNode* joinNode); // returns bitmask of slice vars in subtree
+  static vector<Assignment> getSliceAssignments( // Gray-code order if subtreeMemo else decreasing predicted width (if few)
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    Int sliceVarOrderHeuristic
+  );
+  static Number getSliceCombination(const vector<Number>& solutions, bool additive); // max, log-sum-exp, or exact sum
+  static Number getSliceFold( // combines slices that agree on outer vars with inner op, then groups with outer op
+    const vector<Assignment>& assignments,
+    const vector<Number>& sliceSolutions
+  );
   static Number solveCnf(
     const JoinNonterminal* joinRoot,
     const Map<Int, Int>& cnfVarToDdVarMap,
@@ -222,6 +588,28 @@ public:
   static void printArbRow(const Number& solution, bool frac, size_t keyWidth); // "c s exact arb {notation} {count}"
   static void printDoubleRow(const Number& solution, size_t keyWidth); // "c s exact double prec-sci {count}"
   static void printSolutionRows(const Number& solution, bool surelyUnsat = false, size_t keyWidth = 0);
+  static bool setMaxProjectionNodes(const JoinNode* joinNode); // some var projected in subtree is maximized
+  static Dd solveCheckpointSubtree( // keeps child diagrams of each node in Executor::maxProjectionNodes
+    const JoinNode* joinNode,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    const Assignment& assignment,
+    Map<Int, vector<Dd>>& checkpointDds // nodeIndex |-> child diagrams
+  );
+  static void recomputeSubtreeMaximizer( // fixes max vars of joinNode by joining its checkpoint then descends with them assigned
+    const JoinNode* joinNode,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap,
+    const Cudd* mgr,
+    Assignment& assignment,
+    Map<Int, vector<Dd>>& checkpointDds // entry of joinNode is released
+  );
+  static void recomputeMaximizer( // extends Executor::maximizerSlice to all max vars
+    const JoinNonterminal* joinRoot,
+    const Map<Int, Int>& cnfVarToDdVarMap,
+    const vector<Int>& ddVarToCnfVarMap
+  );
   static void printMaximizerRow(const vector<Int>& ddVarToCnfVarMap);
 
   Executor(const JoinNonterminal* joinRoot, Int ddVarOrderHeuristic, Int sliceVarOrderHeuristic);
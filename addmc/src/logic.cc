@@ -38,7 +38,6 @@ string util::helpVarOrderHeuristic(string prefix) {
   string s = prefix + " var order";
 
   if (prefix == "slice") {
-    s += useDdPackage(CUDD);
     heuristics = getVarOrderHeuristics();
   }
   else {
@@ -59,6 +58,21 @@ string util::helpVerboseSolving() {
   return "verbose solving: 0, 1, 2; int";
 }
 
+void util::updateFnvHash(size_t& hash, Int n) {
+  for (Int byteIndex = 0; byteIndex < sizeof(Int); byteIndex++) {
+    hash ^= (static_cast<unsigned long long>(n) >> (8 * byteIndex)) & 0xff;
+    hash *= FNV_PRIME;
+  }
+}
+
+void util::updateFnvHash(size_t& hash, const string& s) {
+  updateFnvHash(hash, static_cast<Int>(s.size()));
+  for (unsigned char c : s) {
+    hash ^= c;
+    hash *= FNV_PRIME;
+  }
+}
+
 TimePoint util::getTimePoint() {
   return std::chrono::steady_clock::now();
 }
@@ -74,6 +88,40 @@ vector<string> util::splitInputLine(string line) {
   return words;
 }
 
+void util::splitInputLine(std::string_view line, vector<std::string_view>& words) {
+  words.clear();
+  size_t i = 0;
+  while (true) {
+    while (i < line.size() && isspace(static_cast<unsigned char>(line[i]))) {
+      i++;
+    }
+    if (i == line.size()) {
+      return;
+    }
+    size_t wordStart = i;
+    while (i < line.size() && !isspace(static_cast<unsigned char>(line[i]))) {
+      i++;
+    }
+    words.push_back(line.substr(wordStart, i - wordStart));
+  }
+}
+
+bool util::scanInt(std::string_view word, Int& n) {
+  size_t i = !word.empty() && (word[0] == '-' || word[0] == '+');
+  if (i == word.size()) {
+    return false;
+  }
+  unsigned long long magnitude = 0;
+  for (; i < word.size(); i++) {
+    if (word[i] < '0' || word[i] > '9' || magnitude > (MAX_INT - 9) / 10) {
+      return false;
+    }
+    magnitude = magnitude * 10 + (word[i] - '0');
+  }
+  n = word[0] == '-' ? -static_cast<Int>(magnitude) : magnitude;
+  return true;
+}
+
 void util::printInputLine(string line, Int lineIndex) {
   cout << "c line " << right << setw(5) << lineIndex << ":" << (line.empty() ? "" : " " + line) << "\n";
 }
@@ -154,6 +202,44 @@ Number::Number(string s) {
   }
 }
 
+string Number::getExactString() const {
+  if (multiplePrecision) {
+    return quotient.get_str();
+  }
+  std::ostringstream stream;
+  stream << std::hexfloat << fraction;
+  return stream.str();
+}
+
+mpq_class Number::getExactQuotient() const {
+  if (multiplePrecision) {
+    return quotient;
+  }
+  int exponent;
+  Float mantissa = frexpl(fraction, &exponent); // fraction == mantissa * 2^exponent, 0.5 <= |mantissa| < 1
+  unsigned long significand = ldexpl(fabsl(mantissa), 64); // 64-bit long double significand is exact
+  mpq_class q = mpz_class(significand);
+  if (exponent >= 64) {
+    mpq_mul_2exp(q.get_mpq_t(), q.get_mpq_t(), exponent - 64);
+  }
+  else {
+    mpq_div_2exp(q.get_mpq_t(), q.get_mpq_t(), 64 - exponent);
+  }
+  return mantissa < 0 ? mpq_class(-q) : q;
+}
+
+Float Number::getNearestFraction(const mpq_class& q) {
+  mpf_class f(q, 128); // bits
+  mp_exp_t exponent;
+  string digits = f.get_str(exponent, 10, 25); // f == 0.{digits} * 10^exponent
+  string sign = "";
+  if (!digits.empty() && digits.front() == '-') {
+    sign = "-";
+    digits.erase(0, 1);
+  }
+  return stold(sign + "0." + digits + "e" + to_string(exponent));
+}
+
 Float Number::getLogSumExp(const Number& n) const {
   assert(logCounting);
   if (fraction == -INF) {
@@ -254,83 +340,6 @@ void Graph::addEdge(Int v1, Int v2) {
   adjacencyMap.at(v2).insert(v1);
 }
 
-bool Graph::isNeighbor(Int v1, Int v2) const {
-  return adjacencyMap.at(v1).contains(v2);
-}
-
-bool Graph::hasPath(Int from, Int to, Set<Int>& visitedVertices) const {
-  if (from == to) {
-    return true;
-  }
-
-  visitedVertices.insert(from);
-
-  Set<Int> unvisitedNeighbors = util::getDiff(adjacencyMap.at(from), visitedVertices);
-
-  for (Int v : unvisitedNeighbors) {
-    if (hasPath(v, to, visitedVertices)) {
-      return true;
-    }
-  }
-  return false;
-}
-
-bool Graph::hasPath(Int from, Int to) const {
-  Set<Int> visitedVertices;
-  return hasPath(from, to, visitedVertices);
-}
-
-void Graph::removeVertex(Int v) {
-  vertices.erase(v);
-
-  adjacencyMap.erase(v); // edges from v
-
-  for (pair<const Int, Set<Int>>& vertexAndNeighbors : adjacencyMap) {
-    vertexAndNeighbors.second.erase(v); // edge to v
-  }
-}
-
-void Graph::fillInEdges(Int v) {
-  const Set<Int>& neighbors = adjacencyMap.at(v);
-  for (auto neighbor1 = neighbors.begin(); neighbor1 != neighbors.end(); neighbor1++) {
-    for (auto neighbor2 = next(neighbor1); neighbor2 != neighbors.end(); neighbor2++) {
-      addEdge(*neighbor1, *neighbor2);
-    }
-  }
-}
-
-Int Graph::countFillInEdges(Int v) const {
-  Int count = 0;
-  const Set<Int>& neighbors = adjacencyMap.at(v);
-  for (auto neighbor1 = neighbors.begin(); neighbor1 != neighbors.end(); neighbor1++) {
-    for (auto neighbor2 = next(neighbor1); neighbor2 != neighbors.end(); neighbor2++) {
-      if (!isNeighbor(*neighbor1, *neighbor2)) {
-        count++;
-      }
-    }
-  }
-  return count;
-}
-
-Int Graph::getMinfillVertex() const {
-  Int vertex = MIN_INT;
-  Int fillInEdgeCount = MAX_INT;
-
-  for (Int v : vertices) {
-    Int count = countFillInEdges(v);
-    if (count < fillInEdgeCount) {
-      fillInEdgeCount = count;
-      vertex = v;
-    }
-  }
-
-  if (vertex == MIN_INT) {
-    throw MyError("graph has no vertex");
-  }
-
-  return vertex;
-}
-
 /* class Label ============================================================== */
 
 void Label::addNumber(Int i) {
@@ -345,8 +354,8 @@ bool Label::hasSmallerLabel(const pair<Int, Label>& a, const pair <Int, Label>&
 /* class Clause ============================================================= */
 
 void Clause::printClause() const {
-  for (auto it = begin(); it != end(); it++) {
-    cout << " " << right << setw(5) << *it;
+  for (Int literal : *this) {
+    cout << " " << right << setw(5) << literal;
   }
   cout << "\n";
 }
@@ -361,11 +370,26 @@ Set<Int> Clause::getClauseVars() const {
 
 /* class Cnf ================================================================ */
 
+Int Cnf::getClauseCount() const {
+  return clauseOffsets.size() - 1;
+}
+
+Clause Cnf::getClause(Int clauseIndex) const {
+  return Clause(literals.data() + clauseOffsets.at(clauseIndex), literals.data() + clauseOffsets.at(clauseIndex + 1));
+}
+
+std::span<const Int> Cnf::getVarClauses(Int var) const {
+  if (var + 1 >= occurrenceOffsets.size()) {
+    return std::span<const Int>();
+  }
+  return std::span<const Int>(occurrences.data() + occurrenceOffsets.at(var), occurrences.data() + occurrenceOffsets.at(var + 1));
+}
+
 void Cnf::printClauses() const {
   cout << "c cnf formula:\n";
-  for (Int i = 0; i < clauses.size(); i++) {
+  for (Int i = 0; i < getClauseCount(); i++) {
     cout << "c  clause " << right << setw(5) << i + 1 << ":";
-    clauses.at(i).printClause();
+    getClause(i).printClause();
   }
 }
 
@@ -387,30 +411,69 @@ Set<Int> Cnf::getInnerVars() const {
   return innerVars;
 }
 
-void Cnf::addClause(const Clause& clause) {
-  Int clauseIndex = clauses.size();
-  clauses.push_back(clause);
-  for (Int literal : clause) {
-    Int var = abs(literal);
-    auto it = varToClauses.find(var);
-    if (it != varToClauses.end()) {
-      it->second.insert(clauseIndex);
-    }
-    else {
-      varToClauses[var] = Set<Int>{clauseIndex};
+size_t Cnf::getHash() const {
+  size_t hash = FNV_OFFSET_BASIS;
+  util::updateFnvHash(hash, declaredVarCount);
+  for (Int i = 0; i < getClauseCount(); i++) {
+    util::updateFnvHash(hash, 0); // separates clauses
+    Clause clause = getClause(i);
+    vector<Int> sortedLiterals(clause.begin(), clause.end());
+    std::sort(sortedLiterals.begin(), sortedLiterals.end());
+    for (Int literal : sortedLiterals) {
+      util::updateFnvHash(hash, literal);
     }
   }
+  for (Int var = 1; var <= declaredVarCount; var++) {
+    util::updateFnvHash(hash, literalWeights.at(var).getExactString());
+    util::updateFnvHash(hash, literalWeights.at(-var).getExactString());
+  }
+  for (Int var : util::getSortedNums(outerVars)) {
+    util::updateFnvHash(hash, var);
+  }
+  return hash;
 }
 
 void Cnf::setApparentVars() {
-  for (const pair<Int, Set<Int>>& kv : varToClauses) {
-    apparentVars.insert(kv.first);
+  Int maxVar = declaredVarCount; // parser rejects bigger vars
+  vector<Int> lastClauses(maxVar + 1, MIN_INT); // var |-> last clause counted, as clause may contain x and -x
+  occurrenceOffsets.assign(maxVar + 2, 0);
+  for (Int i = 0; i < getClauseCount(); i++) { // counts occurrences of each var
+    for (Int literal : getClause(i)) {
+      Int var = abs(literal);
+      if (lastClauses.at(var) != i) {
+        lastClauses.at(var) = i;
+        occurrenceOffsets.at(var + 1)++;
+      }
+    }
+  }
+  for (Int var = 1; var <= maxVar + 1; var++) { // prefix sums
+    occurrenceOffsets.at(var) += occurrenceOffsets.at(var - 1);
+  }
+
+  occurrences.resize(occurrenceOffsets.back());
+  vector<Int> nextPositions(occurrenceOffsets.begin(), occurrenceOffsets.end() - 1);
+  lastClauses.assign(maxVar + 1, MIN_INT);
+  for (Int i = 0; i < getClauseCount(); i++) {
+    for (Int literal : getClause(i)) {
+      Int var = abs(literal);
+      if (lastClauses.at(var) != i) {
+        lastClauses.at(var) = i;
+        occurrences.at(nextPositions.at(var)++) = i;
+      }
+    }
+  }
+
+  for (Int var = 1; var <= maxVar; var++) {
+    if (occurrenceOffsets.at(var + 1) > occurrenceOffsets.at(var)) {
+      apparentVars.insert(var);
+    }
   }
 }
 
 Graph Cnf::getPrimalGraph() const {
   Graph graph(apparentVars);
-  for (const Clause& clause : clauses) {
+  for (Int i = 0; i < getClauseCount(); i++) {
+    Clause clause = getClause(i);
     for (auto literal1 = clause.begin(); literal1 != clause.end(); literal1++) {
       for (auto literal2 = next(literal1); literal2 != clause.end(); literal2++) {
         Int var1 = abs(*literal1);
@@ -442,8 +505,11 @@ vector<Int> Cnf::getDeclaredVarOrder() const {
 
 vector<Int> Cnf::getMostClausesVarOrder() const {
   multimap<Int, Int, greater<Int>> m; // clause count |-> var
-  for (const pair<Int, Set<Int>>& varAndSet : varToClauses) {
-    m.insert({varAndSet.second.size(), varAndSet.first});
+  for (Int var = 1; var + 1 < occurrenceOffsets.size(); var++) {
+    Int clauseCount = getVarClauses(var).size();
+    if (clauseCount > 0) {
+      m.insert({clauseCount, var});
+    }
   }
 
   vector<Int> varOrder;
@@ -453,18 +519,8 @@ vector<Int> Cnf::getMostClausesVarOrder() const {
   return varOrder;
 }
 
-vector<Int> Cnf::getMinfillVarOrder() const {
-  vector<Int> varOrder;
-
-  Graph graph = getPrimalGraph();
-  while (!graph.vertices.empty()) {
-    Int vertex = graph.getMinfillVertex();
-    graph.fillInEdges(vertex);
-    graph.removeVertex(vertex);
-    varOrder.push_back(vertex);
-  }
-
-  return varOrder;
+vector<Int> Cnf::getEliminationVarOrder(Int heuristic) const {
+  return EliminationGraph(*this).getEliminationOrder(heuristic);
 }
 
 vector<Int> Cnf::getMcsVarOrder() const {
@@ -531,44 +587,78 @@ vector<Int> Cnf::getLexpVarOrder() const {
   return numberedVertices;
 }
 
-vector<Int> Cnf::getLexmVarOrder() const {
-  Map<Int, Label> unnumberedVertices;
-  for (Int vertex : apparentVars) {
-    unnumberedVertices[vertex] = Label();
-  }
+vector<Int> Cnf::getLexmVarOrder() const { // Rose, Tarjan, Lueker (1976), in O(nm) time
+  EliminationGraph graph(*this);
+  Int n = graph.vertexVars.size();
+  vector<Int> labels(n, 0); // vertex |-> rank of lexicographic label among unnumbered vertices
+  Int labelCount = 1;
+  vector<bool> numbered(n, false);
+  vector<Int> reachSteps(n, MIN_INT); // vertex |-> last step in which search reached it
+  vector<vector<Int>> reachSets; // label |-> reached vertices to search from
+  vector<Int> raisedVertices; // reached by paths whose inner vertices have smaller labels
+  vector<Int> labelRanks;
   vector<Int> numberedVertices; // whose alpha numbers are decreasing
-  Graph graph = getPrimalGraph();
-  for (Int i = apparentVars.size(); i > 0; i--) {
-    Int v = max_element(unnumberedVertices.begin(), unnumberedVertices.end(), Label::hasSmallerLabel)->first; // ignores label
-    numberedVertices.push_back(v);
-    unnumberedVertices.erase(v);
-
-    /* updates numberedVertices: */
-    Graph subgraph = getPrimalGraph(); // will only contain v, w, and unnumbered vertices whose labels are less than w's label
-    for (pair<const Int, Label>& wAndLabel : unnumberedVertices) {
-      Int w = wAndLabel.first;
-      Label& wLabel = wAndLabel.second;
-
-      /* removes numbered vertices except v: */
-      for (Int numberedVertex : numberedVertices) {
-        if (numberedVertex != v) {
-          subgraph.removeVertex(numberedVertex);
-        }
+  for (Int step = 0; step < n; step++) {
+    Int v = MIN_INT;
+    for (Int u = 0; u < n; u++) { // smallest var among biggest labels
+      if (!numbered.at(u) && (v == MIN_INT || labels.at(u) > labels.at(v))) {
+        v = u;
       }
-
-      /* removes each non-w unnumbered vertex whose label is not less than w's labels */
-      for (const pair<Int, Label>& kv : unnumberedVertices) {
-        Int unnumberedVertex = kv.first;
-        const Label& label = kv.second;
-        if (unnumberedVertex != w && label >= wLabel) {
-          subgraph.removeVertex(unnumberedVertex);
+    }
+    numbered.at(v) = true;
+    numberedVertices.push_back(graph.vertexVars.at(v));
+
+    reachSets.resize(labelCount);
+    raisedVertices.clear();
+    reachSteps.at(v) = step;
+    for (Int w : graph.adjacency.at(v)) {
+      if (!numbered.at(w)) {
+        reachSteps.at(w) = step;
+        reachSets.at(labels.at(w)).push_back(w);
+        raisedVertices.push_back(w);
+      }
+    }
+    for (Int label = 0; label < labelCount; label++) { // paths with bigger inner labels are searched later
+      while (!reachSets.at(label).empty()) {
+        Int w = reachSets.at(label).back();
+        reachSets.at(label).pop_back();
+        for (Int z : graph.adjacency.at(w)) {
+          if (!numbered.at(z) && reachSteps.at(z) != step) {
+            reachSteps.at(z) = step;
+            if (labels.at(z) > label) {
+              reachSets.at(labels.at(z)).push_back(z);
+              raisedVertices.push_back(z);
+            }
+            else {
+              reachSets.at(label).push_back(z);
+            }
+          }
         }
       }
+    }
 
-      if (subgraph.hasPath(v, w)) {
-        wLabel.addNumber(i);
+    for (Int u = 0; u < n; u++) { // appends current number to labels of raised vertices
+      labels.at(u) *= 2;
+    }
+    for (Int w : raisedVertices) {
+      labels.at(w)++;
+    }
+    labelRanks.assign(2 * labelCount, 0);
+    for (Int u = 0; u < n; u++) {
+      if (!numbered.at(u)) {
+        labelRanks.at(labels.at(u)) = 1;
       }
     }
+    labelCount = 0;
+    for (Int& rank : labelRanks) { // renumbers labels consecutively
+      Int present = rank;
+      rank = labelCount;
+      labelCount += present;
+    }
+    for (Int u = 0; u < n; u++) {
+      labels.at(u) = numbered.at(u) ? 0 : labelRanks.at(labels.at(u));
+    }
+    labelCount = max(labelCount, 1LL);
   }
   return numberedVertices;
 }
@@ -586,7 +676,10 @@ vector<Int> Cnf::getCnfVarOrder(Int cnfVarOrderHeuristic) const {
       varOrder = getMostClausesVarOrder();
       break;
     case MINFILL:
-      varOrder = getMinfillVarOrder();
+    case MIN_DEGREE:
+    case WEIGHTED_MINFILL:
+    case WEIGHTED_MIN_DEGREE:
+      varOrder = getEliminationVarOrder(abs(cnfVarOrderHeuristic));
       break;
     case MCS:
       varOrder = getMcsVarOrder();
@@ -606,127 +699,307 @@ vector<Int> Cnf::getCnfVarOrder(Int cnfVarOrderHeuristic) const {
   return varOrder;
 }
 
-Cnf::Cnf() {}
-
-Cnf::Cnf(string filePath) {
-  cout << "c processing cnf formula...\n";
-
-  std::ifstream inputFileStream(filePath);
-  if (!inputFileStream.is_open()) {
-    throw MyError("unable to open file '", filePath, "'");
-  }
-
-  Int declaredClauseCount = MIN_INT;
-  Int processedClauseCount = 0;
+void Cnf::parseLines(CnfChunk& chunk, const char* begin, const char* end, Int problemLineIndex, Int printedLineOffset) const {
+  vector<Int> literalClauses; // literal + declaredVarCount |-> index of last long clause containing literal (allocated on first long clause)
+  vector<std::string_view> words;
 
-  Int lineIndex = 0;
-  Int problemLineIndex = MIN_INT;
-
-  string line;
-  while (getline(inputFileStream, line)) {
-    lineIndex++;
-    std::istringstream inStringStream(line);
+  for (const char* lineStart = begin; lineStart < end;) {
+    const char* lineEnd = static_cast<const char*>(memchr(lineStart, '\n', end - lineStart));
+    if (lineEnd == nullptr) {
+      lineEnd = end;
+    }
+    std::string_view line(lineStart, lineEnd - lineStart);
+    lineStart = lineEnd == end ? end : lineEnd + 1;
+    Int lineIndex = ++chunk.lineCount;
 
     if (verboseCnf >= RAW_INPUT) {
-      util::printInputLine(line, lineIndex);
+      util::printInputLine(string(line), printedLineOffset + lineIndex);
     }
 
-    vector<string> words = util::splitInputLine(line);
-    if (words.empty()) {}
-    else if (words.front() == "p") { // problem line
-      if (problemLineIndex != MIN_INT) {
-        throw MyError("multiple problem lines: ", problemLineIndex, " and ", lineIndex);
-      }
-      problemLineIndex = lineIndex;
-
-      if (words.size() < 4) {
-        throw MyError("problem line ", lineIndex, " has ", words.size(), " words (should be at least 4)");
+    auto stop = [&](std::function<void(Int)> raiseEvent) {
+      chunk.eventLineIndex = lineIndex;
+      chunk.raiseEvent = raiseEvent;
+    };
+    auto scanWord = [&](Int wordIndex, Int& n) {
+      if (wordIndex < words.size() && util::scanInt(words.at(wordIndex), n)) {
+        return true;
       }
+      stop([wordIndex, lineIndex, line = string(line)](Int lineOffset) {
+        throw MyError("integer expected as word ", wordIndex + 1, " | line ", lineOffset + lineIndex, ": ", line);
+      });
+      return false;
+    };
 
-      declaredVarCount = stoll(words.at(2));
-      declaredClauseCount = stoll(words.at(3));
+    util::splitInputLine(line, words);
+    if (words.empty()) {}
+    else if (words.front() == "p") { // problem line
+      stop([problemLineIndex, lineIndex](Int lineOffset) {
+        throw MyError("multiple problem lines: ", problemLineIndex, " and ", lineOffset + lineIndex);
+      });
+      return;
     }
-    else if (Set<string>{"w", "vp", "c"}.contains(words.front())) { // possibly weight line or show line
+    else if (words.front() == "w" || words.front() == "vp" || words.front() == "c") { // possibly weight line or show line
       if (weightedCounting && (words.front() == "w" || (words.size() > 4 && words.at(1) == "p" && words.at(2) == "weight"))) { // weight line optionally ends with "0"
         if (problemLineIndex == MIN_INT) {
-          throw MyError("no problem line before weighted literal | line ", lineIndex, ": ", line);
+          stop([lineIndex, line = string(line)](Int lineOffset) {
+            throw MyError("no problem line before weighted literal | line ", lineOffset + lineIndex, ": ", line);
+          });
+          return;
         }
 
-        Int literal = stoll(words.at(words.front() == "w" ? 1 : 3));
+        Int literal;
+        Int weightIndex = words.front() == "w" ? 2 : 4;
+        if (!scanWord(weightIndex - 1, literal)) {
+          return;
+        }
 
         if (abs(literal) > declaredVarCount) {
-          throw MyError("literal '", literal, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineIndex);
+          stop([literal, declaredVarCount = declaredVarCount, lineIndex](Int lineOffset) {
+            throw MyError("literal '", literal, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineOffset + lineIndex);
+          });
+          return;
         }
 
-        Number weight(words.at(words.front() == "w" ? 2 : 4));
+        if (weightIndex >= words.size()) {
+          stop([lineIndex, line = string(line)](Int lineOffset) {
+            throw MyError("missing weight | line ", lineOffset + lineIndex, ": ", line);
+          });
+          return;
+        }
+        Number weight{string(words.at(weightIndex))};
         if (weight < Number()) {
-          throw MyError("weight must be non-negative | line ", lineIndex);
+          stop([lineIndex](Int lineOffset) {
+            throw MyError("weight must be non-negative | line ", lineOffset + lineIndex);
+          });
+          return;
         }
-        literalWeights[literal] = weight;
+        chunk.literalWeights.push_back({literal, weight});
       }
       else if (projectedCounting && (words.front() == "vp" || (words.size() > 3 && words.at(1) == "p" && words.at(2) == "show"))) { // show line optionally ends with "0"
         if (problemLineIndex == MIN_INT) {
-          throw MyError("no problem line before projected var | line ", lineIndex, ": ", line);
+          stop([lineIndex, line = string(line)](Int lineOffset) {
+            throw MyError("no problem line before projected var | line ", lineOffset + lineIndex, ": ", line);
+          });
+          return;
         }
 
         for (Int i = (words.front() == "vp" ? 1 : 3); i < words.size(); i++) {
-          Int num = stoll(words.at(i));
+          Int num;
+          if (!scanWord(i, num)) {
+            return;
+          }
           if (num == 0) {
             if (i != words.size() - 1) {
-              throw MyError("outer vars terminated prematurely by '0' | line ", lineIndex);
+              stop([lineIndex](Int lineOffset) {
+                throw MyError("outer vars terminated prematurely by '0' | line ", lineOffset + lineIndex);
+              });
+              return;
             }
           }
           else if (num < 0 || num > declaredVarCount) {
-            throw MyError("var '", num, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineIndex);
+            stop([num, declaredVarCount = declaredVarCount, lineIndex](Int lineOffset) {
+              throw MyError("var '", num, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineOffset + lineIndex);
+            });
+            return;
           }
           else {
-            outerVars.insert(num);
+            chunk.outerVars.push_back(num);
           }
         }
       }
     }
-    else if (Set<string>{"s", "INDETERMINATE"}.contains(words.front())) { // preprocessor pmc
-      throw MyError("unexpected output from preprocessor pmc | line ", lineIndex, ": ", line);
+    else if (words.front() == "s" || words.front() == "INDETERMINATE") { // preprocessor pmc
+      stop([lineIndex, line = string(line)](Int lineOffset) {
+        throw MyError("unexpected output from preprocessor pmc | line ", lineOffset + lineIndex, ": ", line);
+      });
+      return;
     }
     else if (!words.front().starts_with("c")) { // clause line
       if (problemLineIndex == MIN_INT) {
-        throw MyError("no problem line before clause | line ", lineIndex);
+        stop([lineIndex](Int lineOffset) {
+          throw MyError("no problem line before clause | line ", lineOffset + lineIndex);
+        });
+        return;
       }
 
-      Clause clause;
+      Int clauseStart = chunk.literals.size();
+      Int clauseIndex = chunk.clauseOffsets.size() - 1;
       for (Int i = 0; i < words.size(); i++) {
-        Int num = stoll(words.at(i));
+        Int num;
+        if (!scanWord(i, num)) {
+          return;
+        }
 
         if (num > declaredVarCount || num < -declaredVarCount) {
-          throw MyError("literal '", num, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineIndex);
+          stop([num, declaredVarCount = declaredVarCount, lineIndex](Int lineOffset) {
+            throw MyError("literal '", num, "' inconsistent with declared var count '", declaredVarCount, "' | line ", lineOffset + lineIndex);
+          });
+          return;
         }
 
         if (num == 0) {
           if (i != words.size() - 1) {
-            throw MyError("clause terminated prematurely by '0' | line ", lineIndex);
+            stop([lineIndex](Int lineOffset) {
+              throw MyError("clause terminated prematurely by '0' | line ", lineOffset + lineIndex);
+            });
+            return;
           }
 
-          if (clause.empty()) {
-            throw EmptyClauseException(lineIndex, line);
+          if (chunk.literals.size() == clauseStart) {
+            stop([lineIndex, line = string(line)](Int lineOffset) {
+              throw EmptyClauseException(lineOffset + lineIndex, line);
+            });
+            return;
           }
 
-          addClause(clause);
-          processedClauseCount++;
+          chunk.clauseOffsets.push_back(chunk.literals.size());
         }
         else { // literal
           if (i == words.size() - 1) {
-            throw MyError("missing end-of-clause indicator '0' | line ", lineIndex);
+            stop([lineIndex](Int lineOffset) {
+              throw MyError("missing end-of-clause indicator '0' | line ", lineOffset + lineIndex);
+            });
+            return;
+          }
+
+          bool duplicate = false;
+          if (words.size() <= MAX_SCANNED_CLAUSE_LENGTH) {
+            duplicate = std::find(chunk.literals.begin() + clauseStart, chunk.literals.end(), num) != chunk.literals.end();
+          }
+          else {
+            if (literalClauses.empty()) {
+              literalClauses.assign(2 * declaredVarCount + 1, MIN_INT);
+            }
+            duplicate = literalClauses.at(num + declaredVarCount) == clauseIndex;
+            literalClauses.at(num + declaredVarCount) = clauseIndex;
+          }
+          if (!duplicate) {
+            chunk.literals.push_back(num);
           }
-          clause.insert(num);
         }
       }
     }
   }
+}
+
+Cnf::Cnf() {}
 
-  if (problemLineIndex == MIN_INT) {
+Cnf::Cnf(string filePath, Int threadCount) {
+  cout << "c processing cnf formula...\n";
+
+  int fd = open(filePath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw MyError("unable to open file '", filePath, "'");
+  }
+  struct stat fileStat;
+  if (fstat(fd, &fileStat) != 0) {
+    throw MyError("unable to stat file '", filePath, "'");
+  }
+  size_t fileSize = fileStat.st_size;
+  const char* fileStart = "";
+  if (fileSize > 0) {
+    void* mapping = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      throw MyError("unable to map file '", filePath, "'");
+    }
+    madvise(mapping, fileSize, MADV_SEQUENTIAL);
+    fileStart = static_cast<const char*>(mapping);
+  }
+  close(fd);
+  const char* fileEnd = fileStart + fileSize;
+
+  const char* problemLineStart = fileEnd; // first line whose first word is "p"
+  for (const char* lineStart = fileStart; lineStart < fileEnd;) {
+    const char* c = lineStart;
+    while (c < fileEnd && *c != '\n' && isspace(static_cast<unsigned char>(*c))) {
+      c++;
+    }
+    if (c < fileEnd && *c == 'p' && (c + 1 == fileEnd || isspace(static_cast<unsigned char>(c[1])))) {
+      problemLineStart = lineStart;
+      break;
+    }
+    const char* lineEnd = static_cast<const char*>(memchr(c, '\n', fileEnd - c));
+    lineStart = lineEnd == nullptr ? fileEnd : lineEnd + 1;
+  }
+
+  CnfChunk prefixChunk; // lines before problem line may only be comments
+  parseLines(prefixChunk, fileStart, problemLineStart, MIN_INT, 0);
+  if (prefixChunk.eventLineIndex != MIN_INT) {
+    prefixChunk.raiseEvent(0);
+  }
+  Int lineIndex = prefixChunk.lineCount;
+
+  if (problemLineStart == fileEnd) {
     throw MyError("no problem line before cnf file ends on line ", lineIndex);
   }
 
+  const char* problemLineEnd = static_cast<const char*>(memchr(problemLineStart, '\n', fileEnd - problemLineStart));
+  if (problemLineEnd == nullptr) {
+    problemLineEnd = fileEnd;
+  }
+  string line(problemLineStart, problemLineEnd);
+  lineIndex++;
+  if (verboseCnf >= RAW_INPUT) {
+    util::printInputLine(line, lineIndex);
+  }
+  Int problemLineIndex = lineIndex;
+  vector<string> words = util::splitInputLine(line);
+  if (words.size() < 4) {
+    throw MyError("problem line ", lineIndex, " has ", words.size(), " words (should be at least 4)");
+  }
+  declaredVarCount = stoll(words.at(2));
+  Int declaredClauseCount = stoll(words.at(3));
+
+  const char* bodyStart = problemLineEnd == fileEnd ? fileEnd : problemLineEnd + 1;
+  Int chunkCount = verboseCnf >= RAW_INPUT ? 1 : max(1LL, min(threadCount, static_cast<Int>(fileEnd - bodyStart) / MIN_CNF_CHUNK_BYTES)); // raw lines are printed in order
+  vector<const char*> chunkStarts{bodyStart};
+  for (Int i = 1; i < chunkCount; i++) { // chunks end at line boundaries
+    const char* chunkStart = max(chunkStarts.back(), bodyStart + (fileEnd - bodyStart) * i / chunkCount);
+    const char* newline = static_cast<const char*>(memchr(chunkStart, '\n', fileEnd - chunkStart));
+    chunkStarts.push_back(newline == nullptr ? fileEnd : newline + 1);
+  }
+  chunkStarts.push_back(fileEnd);
+
+  vector<CnfChunk> chunks(chunkCount);
+  vector<thread> threads;
+  for (Int i = 1; i < chunkCount; i++) {
+    threads.push_back(thread(&Cnf::parseLines, this, std::ref(chunks.at(i)), chunkStarts.at(i), chunkStarts.at(i + 1), problemLineIndex, 0));
+  }
+  parseLines(chunks.front(), chunkStarts.at(0), chunkStarts.at(1), problemLineIndex, lineIndex);
+  for (thread& t : threads) {
+    t.join();
+  }
+
+  Int literalCount = 0;
+  Int clauseCount = 0;
+  for (const CnfChunk& chunk : chunks) {
+    literalCount += chunk.literals.size();
+    clauseCount += chunk.clauseOffsets.size() - 1;
+  }
+  literals.reserve(literalCount);
+  clauseOffsets.reserve(clauseCount + 1);
+  for (CnfChunk& chunk : chunks) { // merges in line order
+    if (chunk.eventLineIndex != MIN_INT) {
+      chunk.raiseEvent(lineIndex);
+    }
+    Int literalOffset = literals.size();
+    literals.insert(literals.end(), chunk.literals.begin(), chunk.literals.end());
+    for (Int i = 1; i < chunk.clauseOffsets.size(); i++) {
+      clauseOffsets.push_back(literalOffset + chunk.clauseOffsets.at(i));
+    }
+    for (const auto& [literal, weight] : chunk.literalWeights) {
+      literalWeights[literal] = weight;
+    }
+    outerVars.insert(chunk.outerVars.begin(), chunk.outerVars.end());
+    lineIndex += chunk.lineCount;
+    chunk = CnfChunk(); // frees chunk before next one is copied
+  }
+  Int processedClauseCount = getClauseCount();
+
+  if (fileSize > 0) {
+    munmap(const_cast<char*>(fileStart), fileSize);
+  }
+
   setApparentVars();
 
   if (!projectedCounting) {
@@ -787,6 +1060,146 @@ Cnf::Cnf(string filePath) {
   cout << "\n";
 }
 
+/* class EliminationGraph =================================================== */
+
+EliminationGraph::EliminationGraph(const Cnf& cnf) {
+  vector<Int> varVertices(cnf.declaredVarCount + 1, MIN_INT);
+  for (Int var = 1; var <= cnf.declaredVarCount; var++) {
+    if (cnf.apparentVars.contains(var)) {
+      varVertices.at(var) = vertexVars.size();
+      vertexVars.push_back(var);
+      vertexWeights.push_back(cnf.getVarClauses(var).size());
+    }
+  }
+
+  adjacency.resize(vertexVars.size());
+  for (Int i = 0; i < cnf.getClauseCount(); i++) {
+    Clause clause = cnf.getClause(i);
+    for (auto literal1 = clause.begin(); literal1 != clause.end(); literal1++) {
+      for (auto literal2 = next(literal1); literal2 != clause.end(); literal2++) {
+        Int v1 = varVertices.at(abs(*literal1));
+        Int v2 = varVertices.at(abs(*literal2));
+        if (v1 != v2) {
+          adjacency.at(v1).push_back(v2);
+          adjacency.at(v2).push_back(v1);
+        }
+      }
+    }
+  }
+  for (vector<Int>& neighbors : adjacency) {
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+  }
+
+  vertexStamps.assign(vertexVars.size(), 0);
+}
+
+Float EliminationGraph::getScore(Int v, Int heuristic) {
+  const vector<Int>& neighbors = adjacency.at(v);
+  if (heuristic == MIN_DEGREE) {
+    return neighbors.size();
+  }
+
+  Float weightSum = 0;
+  Float squaredWeightSum = 0;
+  for (Int u : neighbors) {
+    weightSum += vertexWeights.at(u);
+    squaredWeightSum += vertexWeights.at(u) * vertexWeights.at(u);
+  }
+  if (heuristic == WEIGHTED_MIN_DEGREE) {
+    return weightSum;
+  }
+
+  stamp++;
+  for (Int u : neighbors) {
+    vertexStamps.at(u) = stamp;
+  }
+  Float edgeCount = 0; // among neighbors
+  Float edgeWeight = 0;
+  for (Int u : neighbors) {
+    for (auto it = std::upper_bound(adjacency.at(u).begin(), adjacency.at(u).end(), u); it != adjacency.at(u).end(); it++) { // each edge once
+      if (vertexStamps.at(*it) == stamp) {
+        edgeCount++;
+        edgeWeight += vertexWeights.at(u) * vertexWeights.at(*it);
+      }
+    }
+  }
+
+  if (heuristic == MINFILL) {
+    return neighbors.size() * (neighbors.size() - 1.0) / 2 - edgeCount;
+  }
+  assert(heuristic == WEIGHTED_MINFILL);
+  return (weightSum * weightSum - squaredWeightSum) / 2 - edgeWeight;
+}
+
+void EliminationGraph::eliminate(Int v) {
+  vector<Int> neighbors;
+  neighbors.swap(adjacency.at(v));
+  vector<Int> merged;
+  for (Int u : neighbors) {
+    vector<Int>& uNeighbors = adjacency.at(u);
+    uNeighbors.erase(std::lower_bound(uNeighbors.begin(), uNeighbors.end(), v));
+    merged.clear();
+    std::set_union(uNeighbors.begin(), uNeighbors.end(), neighbors.begin(), neighbors.end(), back_inserter(merged));
+    merged.erase(std::lower_bound(merged.begin(), merged.end(), u)); // u is in neighbors of v
+    uNeighbors.swap(merged);
+  }
+}
+
+vector<Int> EliminationGraph::getEliminationOrder(Int heuristic) {
+  vector<Float> scores(vertexVars.size());
+  vector<bool> eliminated(vertexVars.size(), false);
+  std::priority_queue<pair<Float, Int>, vector<pair<Float, Int>>, greater<pair<Float, Int>>> queue; // lazy deletion of stale scores
+  for (Int v = 0; v < vertexVars.size(); v++) {
+    scores.at(v) = getScore(v, heuristic);
+    queue.push({scores.at(v), v});
+  }
+
+  bool updatingSecondNeighbors = heuristic == MINFILL || heuristic == WEIGHTED_MINFILL; // fill-in of w depends on edges among neighbors of w
+  vector<Int> varOrder;
+  vector<Int> updatedVertices;
+  while (!queue.empty()) {
+    auto [score, v] = queue.top();
+    queue.pop();
+    if (eliminated.at(v) || score != scores.at(v)) {
+      continue;
+    }
+    varOrder.push_back(vertexVars.at(v));
+    eliminated.at(v) = true;
+
+    vector<Int> neighbors = adjacency.at(v);
+    eliminate(v);
+
+    Int firstHit = stamp + 1; // stamp of other vertex w that neighbors v once
+    stamp += 2; // of updated vertices
+    updatedVertices = neighbors;
+    for (Int u : neighbors) {
+      vertexStamps.at(u) = stamp;
+    }
+    if (updatingSecondNeighbors) { // fill-in of w changes only if at least 2 of its neighbors neighbor v
+      for (Int u : neighbors) {
+        for (Int w : adjacency.at(u)) {
+          if (vertexStamps.at(w) < firstHit) {
+            vertexStamps.at(w) = firstHit;
+          }
+          else if (vertexStamps.at(w) == firstHit) {
+            vertexStamps.at(w) = stamp;
+            updatedVertices.push_back(w);
+          }
+        }
+      }
+    }
+    for (Int u : updatedVertices) { // getScore reuses stamps
+      Float newScore = getScore(u, heuristic);
+      if (newScore != scores.at(u)) {
+        scores.at(u) = newScore;
+        queue.push({newScore, u});
+      }
+    }
+  }
+  return varOrder;
+}
+
 /* classes for join trees =================================================== */
 
 /* class Assignment ========================================================= */
@@ -794,7 +1207,85 @@ Cnf::Cnf(string filePath) {
 Assignment::Assignment() {}
 
 Assignment::Assignment(Int var, bool val) {
-  insert({var, val});
+  assign(var, val);
+}
+
+bool Assignment::contains(Int var) const {
+  if (!denseVals.empty()) {
+    return var < denseVals.size() && denseVals.at(var) >= 0;
+  }
+  for (const auto& [assignedVar, val] : varVals) { // few slice vars
+    if (assignedVar == var) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Assignment::at(Int var) const {
+  if (!denseVals.empty() && var < denseVals.size() && denseVals.at(var) >= 0) {
+    return denseVals.at(var);
+  }
+  for (const auto& [assignedVar, val] : varVals) {
+    if (assignedVar == var) {
+      return val;
+    }
+  }
+  throw MyError("unassigned var ", var);
+}
+
+void Assignment::assign(Int var, bool val) {
+  if (!denseVals.empty()) { // scans varVals only to change an assigned val
+    if (var >= denseVals.size()) {
+      denseVals.resize(var + 1, -1);
+    }
+    int8_t oldVal = denseVals.at(var);
+    denseVals.at(var) = val;
+    if (oldVal < 0) {
+      varVals.push_back({var, val});
+      return;
+    }
+    if (oldVal == val) {
+      return;
+    }
+  }
+  bool found = false;
+  for (auto& [assignedVar, assignedVal] : varVals) {
+    if (assignedVar == var) {
+      assignedVal = val;
+      found = true;
+    }
+  }
+  if (!found) {
+    varVals.push_back({var, val});
+  }
+}
+
+void Assignment::densify() {
+  Int maxVar = 0;
+  for (const auto& [var, val] : varVals) {
+    maxVar = max(maxVar, var);
+  }
+  denseVals.assign(maxVar + 1, -1);
+  for (const auto& [var, val] : varVals) {
+    denseVals.at(var) = val;
+  }
+}
+
+Int Assignment::size() const {
+  return varVals.size();
+}
+
+bool Assignment::empty() const {
+  return varVals.empty();
+}
+
+vector<pair<Int, bool>>::const_iterator Assignment::begin() const {
+  return varVals.begin();
+}
+
+vector<pair<Int, bool>>::const_iterator Assignment::end() const {
+  return varVals.end();
 }
 
 void Assignment::printAssignment() const {
@@ -814,9 +1305,9 @@ vector<Assignment> Assignment::extendAssignments(const vector<Assignment>& assig
   }
   else {
     for (Assignment assignment : assignments) {
-      assignment[var] = false;
+      assignment.assign(var, false);
       extendedAssignments.push_back(assignment);
-      assignment[var] = true;
+      assignment.assign(var, true);
       extendedAssignments.push_back(assignment);
     }
   }
@@ -903,14 +1394,37 @@ bool JoinNode::isTerminal() const {
   return nodeIndex < terminalCount;
 }
 
+void JoinNode::updateSubtreeHash(size_t& hash) const {
+  util::updateFnvHash(hash, nodeIndex);
+  for (Int var : util::getSortedNums(projectionVars)) {
+    util::updateFnvHash(hash, var);
+  }
+  util::updateFnvHash(hash, static_cast<Int>(children.size()));
+  for (const JoinNode* child : children) {
+    util::updateFnvHash(hash, -1); // separates children
+    child->updateSubtreeHash(hash);
+  }
+}
+
 /* class JoinTerminal ======================================================= */
 
 Int JoinTerminal::getWidth(const Assignment& assignment) const {
   return util::getDiff(preProjectionVars, assignment).size();
 }
 
+Int JoinTerminal::getSliceWidth(const Assignment& assignment, Set<Int>& postProjectionVars) const {
+  for (Int literal : cnf.getClause(nodeIndex)) {
+    if (assignment.contains(abs(literal)) && assignment.at(abs(literal)) == (literal > 0)) { // satisfied clause becomes constant
+      postProjectionVars.clear();
+      return 0;
+    }
+  }
+  postProjectionVars = util::getDiff(preProjectionVars, assignment);
+  return postProjectionVars.size();
+}
+
 void JoinTerminal::updateVarSizes(Map<Int, size_t>& varSizes) const {
-  Set<Int> vars = cnf.clauses.at(nodeIndex).getClauseVars();
+  Set<Int> vars = cnf.getClause(nodeIndex).getClauseVars();
   for (Int var : vars) {
     varSizes[var] = max(varSizes[var], vars.size());
   }
@@ -921,7 +1435,7 @@ JoinTerminal::JoinTerminal() {
   terminalCount++;
   nodeCount++;
 
-  preProjectionVars = cnf.clauses.at(nodeIndex).getClauseVars();
+  preProjectionVars = cnf.getClause(nodeIndex).getClauseVars();
 }
 
 /* class JoinNonterminal ===================================================== */
@@ -958,6 +1472,19 @@ Int JoinNonterminal::getWidth(const Assignment& assignment) const {
   return width;
 }
 
+Int JoinNonterminal::getSliceWidth(const Assignment& assignment, Set<Int>& postProjectionVars) const {
+  Int width = 0;
+  Set<Int> vars;
+  for (JoinNode* child : children) {
+    Set<Int> childVars;
+    width = max(width, child->getSliceWidth(assignment, childVars));
+    util::unionize(vars, childVars);
+  }
+  width = max(width, static_cast<Int>(vars.size()));
+  postProjectionVars = util::getDiff(vars, projectionVars);
+  return width;
+}
+
 void JoinNonterminal::updateVarSizes(Map<Int, size_t>& varSizes) const {
   for (Int var : preProjectionVars) {
     varSizes[var] = max(varSizes[var], preProjectionVars.size());
@@ -1048,13 +1575,37 @@ vector<Int> JoinNonterminal::getVarOrder(Int varOrderHeuristic) const {
   return varOrder;
 }
 
+vector<Int> JoinNonterminal::getSliceVarOrder(Int varOrderHeuristic) const {
+  vector<Int> varOrder = getVarOrder(varOrderHeuristic);
+  vector<Int> sliceVarOrder;
+  Set<Int> orderedOuterVars;
+  for (Int var : varOrder) {
+    if (cnf.outerVars.contains(var)) {
+      sliceVarOrder.push_back(var);
+      orderedOuterVars.insert(var);
+    }
+  }
+
+  for (Int var : cnf.apparentVars) {
+    if (cnf.outerVars.contains(var) && !orderedOuterVars.contains(var)) { // inner var cannot be sliced above unsliced outer var
+      return sliceVarOrder;
+    }
+  }
+  for (Int var : varOrder) {
+    if (!cnf.outerVars.contains(var) && cnf.apparentVars.contains(var)) {
+      sliceVarOrder.push_back(var);
+    }
+  }
+  return sliceVarOrder;
+}
+
 vector<Assignment> JoinNonterminal::getOuterAssignments(Int varOrderHeuristic, Int sliceVarCount) const {
   if (sliceVarCount <= 0) {
     return vector<Assignment>{Assignment()};
   }
 
   TimePoint sliceVarOrderStartPoint = util::getTimePoint();
-  vector<Int> varOrder = getVarOrder(varOrderHeuristic);
+  vector<Int> varOrder = getSliceVarOrder(varOrderHeuristic);
   if (verboseSolving >= 1) {
     util::printRow("sliceVarSeconds", util::getDuration(sliceVarOrderStartPoint));
   }
@@ -1066,14 +1617,11 @@ vector<Assignment> JoinNonterminal::getOuterAssignments(Int varOrderHeuristic, I
     cout << "c slice var order: {";
   }
 
-  for (Int i = 0, assignedVars = 0; i < varOrder.size() && assignedVars < sliceVarCount; i++) {
+  for (Int i = 0; i < varOrder.size() && i < sliceVarCount; i++) {
     Int var = varOrder.at(i);
-    if (cnf.outerVars.contains(var)) {
-      assignments = Assignment::extendAssignments(assignments, var);
-      assignedVars++;
-      if (verboseSolving >= 2) {
-        cout << " " << var;
-      }
+    assignments = Assignment::extendAssignments(assignments, var);
+    if (verboseSolving >= 2) {
+      cout << " " << var;
     }
   }
 
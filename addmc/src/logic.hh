@@ -2,8 +2,13 @@
 
 /* inclusions =============================================================== */
 
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <fcntl.h>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
@@ -13,8 +18,14 @@
 #include <random>
 #include <set>
 #include <signal.h>
+#include <span>
+#include <string_view>
+#include <sstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/time.h>
 #include <thread>
+#include <unistd.h>
 #include <unordered_set>
 
 #include <gmpxx.h>
@@ -57,6 +68,9 @@ const Int MAX_INT = std::numeric_limits<Int>::max();
 
 const Float INF = std::numeric_limits<Float>::infinity();
 
+const size_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const size_t FNV_PRIME = 1099511628211ULL;
+
 const string JT_WORD = "jt";
 const string VAR_ELIM_WORD = "e";
 
@@ -84,6 +98,9 @@ const Int MINFILL = 3;
 const Int MCS = 4;
 const Int LEXP = 5;
 const Int LEXM = 6;
+const Int MIN_DEGREE = 9;
+const Int WEIGHTED_MINFILL = 10; // fill-in edge weighs product of clause counts of its vars
+const Int WEIGHTED_MIN_DEGREE = 11; // neighbor weighs its clause count
 const map<Int, string> CNF_VAR_ORDER_HEURISTICS = {
   {RANDOM, "RANDOM"},
   {DECLARED, "DECLARED"},
@@ -91,7 +108,10 @@ const map<Int, string> CNF_VAR_ORDER_HEURISTICS = {
   {MINFILL, "MINFILL"},
   {MCS, "MCS"},
   {LEXP, "LEXP"},
-  {LEXM, "LEXM"}
+  {LEXM, "LEXM"},
+  {MIN_DEGREE, "MIN_DEGREE"},
+  {WEIGHTED_MINFILL, "WEIGHTED_MINFILL"},
+  {WEIGHTED_MIN_DEGREE, "WEIGHTED_MIN_DEGREE"}
 };
 
 const Int BIGGEST_NODE = 7;
@@ -114,6 +134,9 @@ const map<string, string> CLUSTERING_HEURISTICS = {
 
 const Int PARSED_INPUT = 1;
 const Int RAW_INPUT = 2;
+
+const Int MIN_CNF_CHUNK_BYTES = 1 << 20; // per parser thread
+const Int MAX_SCANNED_CLAUSE_LENGTH = 32; // duplicate literals of longer clauses are found with stamp array
 const string INPUT_VERBOSITIES = to_string(PARSED_INPUT) + ", " + to_string(RAW_INPUT) + "; int";
 
 /* global vars ============================================================== */
@@ -139,10 +162,15 @@ namespace util {
   string helpVarOrderHeuristic(string prefix);
   string helpVerboseSolving();
 
+  void updateFnvHash(size_t& hash, Int n); // FNV-1a over bytes of n
+  void updateFnvHash(size_t& hash, const string& s);
+
   TimePoint getTimePoint();
   Float getDuration(TimePoint start); // in seconds
 
   vector<string> splitInputLine(string line);
+  void splitInputLine(std::string_view line, vector<std::string_view>& words); // zero-copy
+  bool scanInt(std::string_view word, Int& n); // false unless word is optional sign then decimal digits
   void printInputLine(string line, Int lineIndex);
 
   void printRowKey(string key, size_t keyWidth);
@@ -242,6 +270,9 @@ public:
   Number(const Number& n);
   Number(string s = "0"); // `s` is "{int1}/{int2}" or "{float1}"
 
+  string getExactString() const; // hexfloat or "{int1}/{int2}", parsed losslessly by Number(string)
+  mpq_class getExactQuotient() const; // !multiplePrecision: fraction is dyadic
+  static Float getNearestFraction(const mpq_class& q);
   Float getLogSumExp(const Number& n) const; // logCounting
   Float getLog10() const;
   bool operator==(const Number& n) const;
@@ -263,14 +294,6 @@ public:
 
   Graph(const Set<Int>& vs);
   void addEdge(Int v1, Int v2);
-
-  bool isNeighbor(Int v1, Int v2) const;
-  bool hasPath(Int from, Int to, Set<Int>& visitedVertices) const; // path length >= 0
-  bool hasPath(Int from, Int to) const;
-  void removeVertex(Int v); // also removes edges from/to v
-  void fillInEdges(Int v); // does not remove v
-  Int countFillInEdges(Int v) const;
-  Int getMinfillVertex() const;
 };
 
 class Label : public vector<Int> { // for lexicographic search
@@ -279,48 +302,95 @@ public:
   static bool hasSmallerLabel(const pair<Int, Label>& a, const pair <Int, Label>& b);
 };
 
-class Clause : public Set<Int> {
+class Clause : public std::span<const Int> { // view of literals in Cnf::literals
 public:
+  using std::span<const Int>::span;
+
   void printClause() const;
   Set<Int> getClauseVars() const;
 };
 
+class CnfChunk { // parse result of consecutive lines of cnf file
+public:
+  vector<Int> literals;
+  vector<Int> clauseOffsets{0};
+  vector<pair<Int, Number>> literalWeights; // in line order, as later weight lines override
+  vector<Int> outerVars;
+  Int lineCount = 0;
+  Int eventLineIndex = MIN_INT; // first error or empty clause stops parsing of chunk
+  std::function<void(Int lineOffset)> raiseEvent; // called on main thread, as MyError prints on construction
+};
+
 class Cnf {
 public:
-  vector<Clause> clauses;
+  vector<Int> literals; // of all clauses, without duplicates within a clause
+  vector<Int> clauseOffsets{0}; // clause i is literals[clauseOffsets[i], clauseOffsets[i + 1])
+  vector<Int> occurrences; // clause indices grouped by var, ascending within each group
+  vector<Int> occurrenceOffsets; // var v occurs in occurrences[occurrenceOffsets[v], occurrenceOffsets[v + 1])
   Int declaredVarCount = 0;
   Set<Int> apparentVars; // as opposed to hidden vars that are declared but appear in no clause
   Set<Int> outerVars;
   Map<Int, Number> literalWeights;
-  Map<Int, Set<Int>> varToClauses; // var |-> clause indices
+
+  Int getClauseCount() const;
+  Clause getClause(Int clauseIndex) const;
+  std::span<const Int> getVarClauses(Int var) const; // empty for hidden var
 
   void printClauses() const;
   void printLiteralWeights() const;
   Set<Int> getInnerVars() const;
+  size_t getHash() const; // of clauses, literal weights, and outer vars
 
-  void addClause(const Clause& clause);
-  void setApparentVars();
+  void setApparentVars(); // also builds occurrence index
   Graph getPrimalGraph() const;
   vector<Int> getRandomVarOrder() const;
   vector<Int> getDeclaredVarOrder() const;
   vector<Int> getMostClausesVarOrder() const;
-  vector<Int> getMinfillVarOrder() const;
+  vector<Int> getEliminationVarOrder(Int heuristic) const; // min-fill or min-degree, possibly weighted
   vector<Int> getMcsVarOrder() const;
   vector<Int> getLexpVarOrder() const;
   vector<Int> getLexmVarOrder() const;
   vector<Int> getCnfVarOrder(Int cnfVarOrderHeuristic) const;
 
+  void parseLines(CnfChunk& chunk, const char* begin, const char* end, Int problemLineIndex, Int printedLineOffset) const; // line indices of chunk start from 1
+
   Cnf(); // empty conjunction
-  Cnf(string filePath);
+  Cnf(string filePath, Int threadCount); // memory-maps file and parses chunks of lines after problem line in parallel
+};
+
+class EliminationGraph { // primal graph for greedy elimination orders
+public:
+  vector<Int> vertexVars; // vertex |-> var, in ascending order
+  vector<Float> vertexWeights; // vertex |-> clause count of var
+  vector<vector<Int>> adjacency; // vertex |-> sorted uneliminated neighbors
+  vector<Int> vertexStamps; // for neighborhood intersections and update sets
+  Int stamp = 0;
+
+  EliminationGraph(const Cnf& cnf);
+  Float getScore(Int v, Int heuristic); // fill-in or degree, possibly weighted
+  void eliminate(Int v); // connects neighbors of v then removes v
+  vector<Int> getEliminationOrder(Int heuristic); // vars, each eliminated with min score (ties broken by smaller var)
 };
 
 /* classes for join trees =================================================== */
 
-class Assignment : public Map<Int, bool> { // partial var assignment
+class Assignment { // partial var assignment
 public:
+  vector<pair<Int, bool>> varVals; // in order of assignment
+  vector<int8_t> denseVals; // var |-> -1 (unassigned), 0, 1 (empty unless densified)
+
   Assignment();
   Assignment(Int var, bool val);
 
+  bool contains(Int var) const; // O(1) if densified
+  bool at(Int var) const;
+  void assign(Int var, bool val); // overwrites
+  void densify(); // tri-state array up to biggest assigned var, kept by later assign calls
+  Int size() const;
+  bool empty() const;
+  vector<pair<Int, bool>>::const_iterator begin() const;
+  vector<pair<Int, bool>>::const_iterator end() const;
+
   void printAssignment() const;
   static vector<Assignment> extendAssignments(const vector<Assignment>& assignments, Int var);
 };
@@ -346,6 +416,10 @@ public:
   static void restoreStaticFields(); // from backup
 
   virtual Int getWidth(const Assignment& assignment = Assignment()) const = 0; // of subtree
+  virtual Int getSliceWidth( // of subtree, ignoring clauses satisfied by assignment
+    const Assignment& assignment,
+    Set<Int>& postProjectionVars // unassigned vars remaining after projection
+  ) const = 0;
 
   virtual void updateVarSizes(
     Map<Int, size_t>& varSizes // var x |-> size of biggest node containing x
@@ -362,11 +436,13 @@ public:
     string clusteringHeuristic
   ); // rank = |restrictedVarOrder| if restrictedVarOrder \cap postProjectionVars = \emptyset else 0 \le rank < |restrictedVarOrder|
   bool isTerminal() const;
+  void updateSubtreeHash(size_t& hash) const; // node indices and projection vars
 };
 
 class JoinTerminal : public JoinNode {
 public:
   Int getWidth(const Assignment& assignment = Assignment()) const override;
+  Int getSliceWidth(const Assignment& assignment, Set<Int>& postProjectionVars) const override;
 
   void updateVarSizes(Map<Int, size_t>& varSizes) const override;
 
@@ -379,13 +455,15 @@ public:
   void printSubtree(string startWord = "") const; // post-order traversal
 
   Int getWidth(const Assignment& assignment = Assignment()) const override;
+  Int getSliceWidth(const Assignment& assignment, Set<Int>& postProjectionVars) const override;
 
   void updateVarSizes(Map<Int, size_t>& varSizes) const override;
   vector<Int> getBiggestNodeVarOrder() const;
   vector<Int> getHighestNodeVarOrder() const;
   vector<Int> getVarOrder(Int varOrderHeuristic) const;
 
-  vector<Assignment> getOuterAssignments(Int varOrderHeuristic, Int sliceVarCount) const;
+  vector<Int> getSliceVarOrder(Int varOrderHeuristic) const; // outer vars then inner vars (quantified below all outer vars)
+  vector<Assignment> getOuterAssignments(Int varOrderHeuristic, Int sliceVarCount) const; // on first vars of slice var order
 
   JoinNonterminal(
     const vector<JoinNode*>& children,